@@ -29,12 +29,14 @@
 //
 //*****************************************************************************
 
+#include "inc/hw_ints.h"
 #include "inc/hw_ssi.h"
 #include "inc/hw_memmap.h"
 #include "inc/hw_sysctl.h"
 #include "inc/hw_types.h"
 #include "driverlib/debug.h"
 #include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
 #include "driverlib/ssi.h"
 #include "driverlib/sysctl.h"
 #include "rit128x96x4.h"
@@ -66,6 +68,91 @@ static volatile unsigned long g_ulSSIFlags;
 //*****************************************************************************
 static unsigned char g_pucBuffer[8];
 
+//*****************************************************************************
+//
+// Transfer queue to the display.  Each entry is a run of command or data
+// bytes, or for frame data usRows runs of usCount bytes taken one frame row
+// apart, so a flushed rectangle is one entry.  The SSI interrupt handler
+// moves the bytes into the transmit FIFO and switches the D/C line between
+// entries, so the drawing code never waits for the bus.  Short command runs
+// are copied into the entry because they are usually built on the stack or
+// in g_pucBuffer; everything else (the frame and the constant initialization
+// strings) is sent from where it is.
+//
+// g_ulQueueHead is only advanced by the foreground and g_ulQueueTail only by
+// RITQueueService(), which runs either from the SSI interrupt or from the
+// foreground with the SSI interrupt disabled.  g_ulQueueRow and g_ulQueueSent
+// locate the next byte of the tail entry to go into the FIFO.
+//
+//*****************************************************************************
+#define RIT_QUEUE_SIZE          32
+#define RIT_QUEUE_INLINE        8
+typedef struct
+{
+    const unsigned char *pucData;
+    unsigned short usCount;
+    unsigned char ucRows;
+    unsigned char ucData;
+    unsigned char pucInline[RIT_QUEUE_INLINE];
+}
+tRITBatch;
+static tRITBatch g_psQueue[RIT_QUEUE_SIZE];
+static volatile unsigned long g_ulQueueHead;
+static volatile unsigned long g_ulQueueTail;
+static unsigned long g_ulQueueRow;
+static unsigned long g_ulQueueSent;
+static tRIT128x96x4QueueStats g_sQueueStats;
+static void (*g_pfnQueueCallback)(void);
+
+//*****************************************************************************
+//
+// Off-screen copy of the visible display RAM.  The drawing functions render
+// into it and RIT128x96x4Flush() sends the changed bytes to the controller.
+// Each byte holds two pixels, the left one in bits 7:4, exactly as in the
+// SSD1329 display RAM.  For each row, g_pucDirtyLo/Hi hold the range of byte
+// columns that differ from the panel; a row is clean when Lo > Hi.  A byte is
+// only marked when its value changes, so redrawing the same content costs
+// nothing on the bus.
+//
+//*****************************************************************************
+#define RIT_ROWS                96
+#define RIT_COLUMN_BYTES        64
+#define RIT_CLEAN               0xff
+static unsigned char g_pucFrame[RIT_ROWS][RIT_COLUMN_BYTES];
+static unsigned char g_pucDirtyLo[RIT_ROWS];
+static unsigned char g_pucDirtyHi[RIT_ROWS];
+static tBoolean g_bFrameDirty;
+static tBoolean g_bFlushDeferred;
+
+//*****************************************************************************
+//
+// Pre-packed glyphs for the characters ' ' to ':', which covers the digits,
+// the sign, the decimal point and the separators of every number drawn on
+// the display.  Each glyph is 8 rows of 3 bytes, one per pair of columns;
+// a byte holds a 2-bit code, bit 1 for the left pixel and bit 0 for the
+// right pixel, so the same glyph serves every gray level through a 4-entry
+// lookup table.  The cache is built from g_pucFont the first time text is
+// drawn.  g_pucTextRow is the row that text is composed into before it is
+// copied to the off-screen frame.
+//
+//*****************************************************************************
+#define RIT_GLYPH_ROWS          8
+#define RIT_GLYPH_BYTES         3
+#define RIT_GLYPH_CACHED        (':' - ' ' + 1)
+static unsigned char g_pucGlyphCache[RIT_GLYPH_CACHED][RIT_GLYPH_ROWS]
+                                    [RIT_GLYPH_BYTES];
+static tBoolean g_bGlyphCacheValid;
+static unsigned char g_pucTextRow[RIT_COLUMN_BYTES];
+
+//*****************************************************************************
+//
+// Window setup cost in bytes of one flushed rectangle (column and row
+// address commands and the increment mode), used to decide whether two
+// dirty rows are sent as one rectangle or as two.
+//
+//*****************************************************************************
+#define RIT_WINDOW_BYTES        8
+
 //*****************************************************************************
 //
 // Define the SSD1329 128x96x4 Remap Setting(s).  This will be used in
@@ -318,119 +405,468 @@ static const unsigned char g_pucRIT128x96x4Init[] =
 //
 //! \internal
 //!
-//! Write a sequence of command bytes to the SSD1329 controller.
+//! Move queued bytes into the SSI transmit FIFO.
 //!
-//! The data is written in a polled fashion; this function will not return
-//! until the entire byte sequence has been written to the controller.
+//! Runs until the FIFO is full, the queue is empty, or the next run needs the
+//! D/C line changed while the previous bytes are still shifting out.  In the
+//! first case the transmit FIFO interrupt is enabled to continue, in the last
+//! one the receive timeout interrupt, which fires once the bus has been idle
+//! for 32 bit times (each byte sent clocks one byte in).  Must be called with
+//! the SSI interrupt disabled or from its handler.
 //!
 //! \return None.
 //
 //*****************************************************************************
 static void
-RITWriteCommand(const unsigned char *pucBuffer, unsigned long ulCount)
+RITQueueService(void)
+{
+    tRITBatch *psBatch;
+    const unsigned char *pucData;
+    tBoolean bRetired = false;
+
+    while(g_ulQueueTail != g_ulQueueHead)
+    {
+        psBatch = &g_psQueue[g_ulQueueTail % RIT_QUEUE_SIZE];
+
+        //
+        // Switch the D/C line once the bytes of the previous run are out.
+        //
+        if(psBatch->ucData != HWREGBITW(&g_ulSSIFlags, FLAG_DC_HIGH))
+        {
+            if(SSIBusy(SSI0_BASE))
+            {
+                SSIIntDisable(SSI0_BASE, SSI_TXFF);
+                SSIIntClear(SSI0_BASE, SSI_RXTO);
+                SSIIntEnable(SSI0_BASE, SSI_RXTO);
+                return;
+            }
+            GPIOPinWrite(GPIO_OLEDDC_BASE, GPIO_OLEDDC_PIN,
+                         psBatch->ucData ? GPIO_OLEDDC_PIN : 0);
+            HWREGBITW(&g_ulSSIFlags, FLAG_DC_HIGH) = psBatch->ucData;
+        }
+
+        //
+        // Fill the FIFO from this entry.
+        //
+        while(g_ulQueueRow < psBatch->ucRows)
+        {
+            pucData = psBatch->pucData + (g_ulQueueRow * RIT_COLUMN_BYTES);
+            while(g_ulQueueSent < psBatch->usCount)
+            {
+                if(!SSIDataPutNonBlocking(SSI0_BASE, pucData[g_ulQueueSent]))
+                {
+                    SSIIntDisable(SSI0_BASE, SSI_RXTO);
+                    SSIIntEnable(SSI0_BASE, SSI_TXFF);
+                    return;
+                }
+                g_ulQueueSent++;
+            }
+            g_ulQueueSent = 0;
+            g_ulQueueRow++;
+        }
+        g_ulQueueRow = 0;
+        g_ulQueueTail++;
+        bRetired = true;
+    }
+
+    //
+    // Everything is in the FIFO; nothing left to wait for.
+    //
+    SSIIntDisable(SSI0_BASE, SSI_TXFF | SSI_RXTO);
+    if(bRetired && g_pfnQueueCallback)
+    {
+        g_pfnQueueCallback();
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Handles the SSI interrupt: discards the bytes clocked in from the
+//! unconnected receive line and keeps the transfer queue moving.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+RITSSIIntHandler(void)
+{
+    unsigned long ulTemp;
+
+    SSIIntClear(SSI0_BASE, SSI_RXTO | SSI_RXOR);
+    while(SSIDataGetNonBlocking(SSI0_BASE, &ulTemp) != 0)
+    {
+    }
+    RITQueueService();
+}
+
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Queue \e ulRows runs of \e ulCount command (\e ucData = 0) or data
+//! (\e ucData = 1) bytes for the SSD1329 controller, the runs being one
+//! frame row apart in \e pucBuffer.
+//!
+//! A single run of up to RIT_QUEUE_INLINE bytes is copied; anything else is
+//! sent from \e pucBuffer, which must stay valid until it is out.  If the queue is
+//! full, the processor sleeps until the SSI interrupt frees an entry, so this
+//! must not be called from an interrupt handler.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+RITQueuePost(const unsigned char *pucBuffer, unsigned long ulCount,
+             unsigned long ulRows, unsigned char ucData)
 {
+    tRITBatch *psBatch;
+    unsigned long ulIdx, ulDepth;
+
     //
     // Return if SSI port is not enabled for RIT display.
     //
-    if(!HWREGBITW(&g_ulSSIFlags, FLAG_SSI_ENABLED))
+    if(!HWREGBITW(&g_ulSSIFlags, FLAG_SSI_ENABLED) || (ulCount == 0))
     {
         return;
     }
 
     //
-    // See if data mode is enabled.
+    // Wait for a free entry.
     //
-    if(HWREGBITW(&g_ulSSIFlags, FLAG_DC_HIGH))
+    if((g_ulQueueHead - g_ulQueueTail) == RIT_QUEUE_SIZE)
     {
-        //
-        // Wait until the SSI is not busy, meaning that all previous data has
-        // been transmitted.
-        //
-        while(SSIBusy(SSI0_BASE))
+        g_sQueueStats.ulFullWaits++;
+        while((g_ulQueueHead - g_ulQueueTail) == RIT_QUEUE_SIZE)
         {
+            SysCtlSleep();
         }
+    }
 
-        //
-        // Clear the command/control bit to enable command mode.
-        //
-        GPIOPinWrite(GPIO_OLEDDC_BASE, GPIO_OLEDDC_PIN, 0);
-        HWREGBITW(&g_ulSSIFlags, FLAG_DC_HIGH) = 0;
+    psBatch = &g_psQueue[g_ulQueueHead % RIT_QUEUE_SIZE];
+    psBatch->ucData = ucData;
+    psBatch->usCount = ulCount;
+    psBatch->ucRows = ulRows;
+    if((ulRows == 1) && (ulCount <= RIT_QUEUE_INLINE))
+    {
+        for(ulIdx = 0; ulIdx < ulCount; ulIdx++)
+        {
+            psBatch->pucInline[ulIdx] = pucBuffer[ulIdx];
+        }
+        psBatch->pucData = psBatch->pucInline;
+    }
+    else
+    {
+        psBatch->pucData = pucBuffer;
     }
 
+    g_sQueueStats.ulBatches++;
+    g_sQueueStats.ulBytes += ulCount * ulRows;
+
     //
-    // Loop while there are more bytes left to be transferred.
+    // Publish the entry and start the transfer if the bus is idle.
     //
-    while(ulCount != 0)
+    IntDisable(INT_SSI0);
+    g_ulQueueHead++;
+    ulDepth = g_ulQueueHead - g_ulQueueTail;
+    if(ulDepth > g_sQueueStats.ulMaxDepth)
     {
-        //
-        // Write the next byte to the controller.
-        //
-        SSIDataPut(SSI0_BASE, *pucBuffer++);
+        g_sQueueStats.ulMaxDepth = ulDepth;
+    }
+    RITQueueService();
+    IntEnable(INT_SSI0);
+}
 
-        //
-        // Decrement the BYTE counter.
-        //
-        ulCount--;
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Write a sequence of command bytes to the SSD1329 controller.
+//!
+//! The bytes are queued and sent from the SSI interrupt; see RITQueuePost().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+RITWriteCommand(const unsigned char *pucBuffer, unsigned long ulCount)
+{
+    RITQueuePost(pucBuffer, ulCount, 1, 0);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Add the byte columns \e ulLo to \e ulHi of a row to its dirty range.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+RITFrameMark(unsigned long ulRow, unsigned long ulLo, unsigned long ulHi)
+{
+    if(g_pucDirtyLo[ulRow] > g_pucDirtyHi[ulRow])
+    {
+        g_pucDirtyLo[ulRow] = ulLo;
+        g_pucDirtyHi[ulRow] = ulHi;
     }
+    else
+    {
+        if(ulLo < g_pucDirtyLo[ulRow])
+        {
+            g_pucDirtyLo[ulRow] = ulLo;
+        }
+        if(ulHi > g_pucDirtyHi[ulRow])
+        {
+            g_pucDirtyHi[ulRow] = ulHi;
+        }
+    }
+    g_bFrameDirty = true;
 }
 
 //*****************************************************************************
 //
 //! \internal
 //!
-//! Write a sequence of data bytes to the SSD1329 controller.
+//! Write one byte of the off-screen frame and mark it dirty if it changed.
+//! Rows outside of the visible area are ignored.
 //!
-//! The data is written in a polled fashion; this function will not return
-//! until the entire byte sequence has been written to the controller.
+//! \return None.
+//
+//*****************************************************************************
+static void
+RITFramePut(unsigned long ulRow, unsigned long ulColumn, unsigned char ucData)
+{
+    if((ulRow >= RIT_ROWS) || (g_pucFrame[ulRow][ulColumn] == ucData))
+    {
+        return;
+    }
+    g_pucFrame[ulRow][ulColumn] = ucData;
+    RITFrameMark(ulRow, ulColumn, ulColumn);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Write a run of \e ulCount bytes into one row of the off-screen frame.
+//! Only the span between the first and the last changed byte is copied and
+//! added to the dirty range, once for the whole run.  Rows outside of the
+//! visible area are ignored.
 //!
 //! \return None.
 //
 //*****************************************************************************
 static void
-RITWriteData(const unsigned char *pucBuffer, unsigned long ulCount)
+RITFrameRowPut(unsigned long ulRow, unsigned long ulColumn,
+               const unsigned char *pucData, unsigned long ulCount)
 {
-    //
-    // Return if SSI port is not enabled for RIT display.
-    //
-    if(!HWREGBITW(&g_ulSSIFlags, FLAG_SSI_ENABLED))
+    unsigned char *pucFrame;
+    unsigned long ulLo, ulHi;
+
+    if(ulRow >= RIT_ROWS)
     {
         return;
     }
+    pucFrame = &g_pucFrame[ulRow][ulColumn];
 
     //
-    // See if command mode is enabled.
+    // Find the changed span, and return if there is none.
     //
-    if(!HWREGBITW(&g_ulSSIFlags, FLAG_DC_HIGH))
+    for(ulLo = 0; ulLo < ulCount; ulLo++)
+    {
+        if(pucFrame[ulLo] != pucData[ulLo])
+        {
+            break;
+        }
+    }
+    if(ulLo == ulCount)
+    {
+        return;
+    }
+    for(ulHi = ulCount - 1; pucFrame[ulHi] == pucData[ulHi]; ulHi--)
+    {
+    }
+
+    RITFrameMark(ulRow, ulColumn + ulLo, ulColumn + ulHi);
+    for(; ulLo <= ulHi; ulLo++)
+    {
+        pucFrame[ulLo] = pucData[ulLo];
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Send one rectangle of the off-screen frame to the display: a single
+//! window setup (column and row address and increment mode, in one command
+//! run) followed by one burst of data in horizontal increment mode.
+//! The rectangle is queued as one entry straight from the frame; a byte
+//! redrawn before it goes out marks its row dirty again, so the next flush
+//! sends it anyway.
+//!
+//! \return Returns \b false, with nothing queued and the rows still dirty,
+//! if the queue does not have the two free entries the rectangle needs, and
+//! \b true otherwise.
+//
+//*****************************************************************************
+static tBoolean
+RITFrameSend(unsigned long ulRow0, unsigned long ulRow1, unsigned long ulLo,
+             unsigned long ulHi)
+{
+    unsigned long ulRow;
+
+    if((g_ulQueueHead - g_ulQueueTail) > (RIT_QUEUE_SIZE - 2))
+    {
+        return(false);
+    }
+
+    g_pucBuffer[0] = 0x15;
+    g_pucBuffer[1] = ulLo;
+    g_pucBuffer[2] = ulHi;
+    g_pucBuffer[3] = 0x75;
+    g_pucBuffer[4] = ulRow0;
+    g_pucBuffer[5] = ulRow1;
+    g_pucBuffer[6] = g_pucRIT128x96x4HorizontalInc[0];
+    g_pucBuffer[7] = g_pucRIT128x96x4HorizontalInc[1];
+    RITWriteCommand(g_pucBuffer, 8);
+
+    RITQueuePost(&g_pucFrame[ulRow0][ulLo], ulHi - ulLo + 1,
+                 ulRow1 - ulRow0 + 1, 1);
+    for(ulRow = ulRow0; ulRow <= ulRow1; ulRow++)
+    {
+        g_pucDirtyLo[ulRow] = RIT_CLEAN;
+        g_pucDirtyHi[ulRow] = 0;
+    }
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Sends the changed parts of the off-screen frame to the display.
+//!
+//! The drawing functions only update the off-screen frame; this function
+//! brings the display up to date.  Consecutive dirty rows are grouped in a
+//! rectangle spanning all their changed columns as long as that sends fewer
+//! bytes than starting a new rectangle, and each rectangle is sent as one
+//! window setup and one data burst.  It returns immediately when nothing
+//! changed since the last call.
+//!
+//! It never waits for the transfer queue: when the queue has no room for the
+//! next rectangle, the rows not sent yet stay dirty and the next call carries
+//! on from there, so the caller's loop keeps running while the SSI drains.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RIT128x96x4Flush(void)
+{
+    unsigned long ulRow, ulRow0, ulLo, ulHi, ulNewLo, ulNewHi;
+    unsigned long ulMerged, ulSeparate;
+
+    if(!g_bFrameDirty)
+    {
+        return;
+    }
+    g_bFrameDirty = false;
+
+    ulRow0 = RIT_ROWS;
+    ulLo = 0;
+    ulHi = 0;
+    for(ulRow = 0; ulRow <= RIT_ROWS; ulRow++)
     {
         //
-        // Wait until the SSI is not busy, meaning that all previous commands
-        // have been transmitted.
+        // A clean row (or the end of the display) closes the rectangle.
         //
-        while(SSIBusy(SSI0_BASE))
+        if((ulRow == RIT_ROWS) ||
+           (g_pucDirtyLo[ulRow] > g_pucDirtyHi[ulRow]))
+        {
+            if(ulRow0 < RIT_ROWS)
+            {
+                if(!RITFrameSend(ulRow0, ulRow - 1, ulLo, ulHi))
+                {
+                    break;
+                }
+                ulRow0 = RIT_ROWS;
+            }
+            continue;
+        }
+
+        if(ulRow0 == RIT_ROWS)
         {
+            ulRow0 = ulRow;
+            ulLo = g_pucDirtyLo[ulRow];
+            ulHi = g_pucDirtyHi[ulRow];
+            continue;
         }
 
         //
-        // Set the command/control bit to enable data mode.
+        // Grow the rectangle with this row, or close it and start another
+        // one, whichever sends fewer bytes.
         //
-        GPIOPinWrite(GPIO_OLEDDC_BASE, GPIO_OLEDDC_PIN, GPIO_OLEDDC_PIN);
-        HWREGBITW(&g_ulSSIFlags, FLAG_DC_HIGH) = 1;
+        ulNewLo = (g_pucDirtyLo[ulRow] < ulLo) ? g_pucDirtyLo[ulRow] : ulLo;
+        ulNewHi = (g_pucDirtyHi[ulRow] > ulHi) ? g_pucDirtyHi[ulRow] : ulHi;
+        ulMerged = (ulRow - ulRow0 + 1) * (ulNewHi - ulNewLo + 1);
+        ulSeparate = ((ulRow - ulRow0) * (ulHi - ulLo + 1)) +
+                     RIT_WINDOW_BYTES +
+                     (g_pucDirtyHi[ulRow] - g_pucDirtyLo[ulRow] + 1);
+        if(ulMerged <= ulSeparate)
+        {
+            ulLo = ulNewLo;
+            ulHi = ulNewHi;
+        }
+        else
+        {
+            if(!RITFrameSend(ulRow0, ulRow - 1, ulLo, ulHi))
+            {
+                break;
+            }
+            ulRow0 = ulRow;
+            ulLo = g_pucDirtyLo[ulRow];
+            ulHi = g_pucDirtyHi[ulRow];
+        }
     }
 
     //
-    // Loop while there are more bytes left to be transferred.
+    // The queue is full: leave the rest for the next call.
     //
-    while(ulCount != 0)
+    if(ulRow <= RIT_ROWS)
     {
-        //
-        // Write the next byte to the controller.
-        //
-        SSIDataPut(SSI0_BASE, *pucBuffer++);
+        g_bFrameDirty = true;
+        if(!g_bFlushDeferred)
+        {
+            g_sQueueStats.ulDeferrals++;
+        }
+    }
+    g_bFlushDeferred = (ulRow <= RIT_ROWS);
+}
 
-        //
-        // Decrement the BYTE counter.
-        //
-        ulCount--;
+//*****************************************************************************
+//
+//! Clears the off-screen frame.
+//!
+//! All pixels of the off-screen frame are turned off; the display is blanked
+//! by the next call to RIT128x96x4Flush(), which only sends the rows that were
+//! not already blank.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RIT128x96x4FrameClear(void)
+{
+    unsigned long ulRow, ulColumn;
+
+    for(ulRow = 0; ulRow < RIT_ROWS; ulRow++)
+    {
+        for(ulColumn = 0; ulColumn < RIT_COLUMN_BYTES; ulColumn++)
+        {
+            RITFramePut(ulRow, ulColumn, 0);
+        }
     }
 }
 
@@ -438,8 +874,8 @@ RITWriteData(const unsigned char *pucBuffer, unsigned long ulCount)
 //
 //! Clears the OLED display.
 //!
-//! This function will clear the display RAM.  All pixels in the display will
-//! be turned off.
+//! This function will clear the display RAM and the off-screen frame.  All
+//! pixels in the display will be turned off immediately.
 //!
 //! \return None.
 //
@@ -448,14 +884,22 @@ void
 RIT128x96x4Clear(void)
 {
     static const unsigned char pucCommand1[] = { 0x15, 0, 63 };
-    static const unsigned char pucCommand2[] = { 0x75, 0, 127 };
+    static const unsigned char pucCommand2[] = { 0x75, 0, 95 };
     unsigned long ulRow, ulColumn;
 
     //
-    // Clear out the buffer used for sending bytes to the display.
+    // The off-screen frame is blank and in sync with the display.
     //
-    *(unsigned long *)&g_pucBuffer[0] = 0;
-    *(unsigned long *)&g_pucBuffer[4] = 0;
+    for(ulRow = 0; ulRow < RIT_ROWS; ulRow++)
+    {
+        for(ulColumn = 0; ulColumn < RIT_COLUMN_BYTES; ulColumn++)
+        {
+            g_pucFrame[ulRow][ulColumn] = 0;
+        }
+        g_pucDirtyLo[ulRow] = RIT_CLEAN;
+        g_pucDirtyHi[ulRow] = 0;
+    }
+    g_bFrameDirty = false;
 
     //
     // Set the window to fill the entire display.
@@ -466,24 +910,204 @@ RIT128x96x4Clear(void)
                     sizeof(g_pucRIT128x96x4HorizontalInc));
 
     //
-    // Loop through the rows
+    // Send the blank frame as one entry.
     //
-    for(ulRow = 0; ulRow < 96; ulRow++)
+    RITQueuePost(g_pucFrame[0], RIT_COLUMN_BYTES, RIT_ROWS, 1);
+}
+
+//*****************************************************************************
+//
+//! Determines whether the display transfer queue is still draining.
+//!
+//! \return Returns \b true if queued bytes have not all been written to the
+//! SSI FIFO yet, and \b false otherwise.
+//
+//*****************************************************************************
+tBoolean
+RIT128x96x4Busy(void)
+{
+    return(g_ulQueueHead != g_ulQueueTail);
+}
+
+//*****************************************************************************
+//
+//! Determines whether the display is still being brought up to date.
+//!
+//! \return Returns \b true if the transfer queue is still draining, or if the
+//! off-screen frame has changes that RIT128x96x4Flush() has not queued yet
+//! (for example because it found the queue full), and \b false otherwise.
+//
+//*****************************************************************************
+tBoolean
+RIT128x96x4Pending(void)
+{
+    return(RIT128x96x4Busy() || g_bFrameDirty);
+}
+
+//*****************************************************************************
+//
+//! Sets the function called when the display transfer queue empties.
+//!
+//! \param pfnCallback is the function to call, or 0 for none.
+//!
+//! The callback runs from the SSI interrupt handler, or from the drawing code
+//! when a transfer fits in the FIFO, once the last queued byte has been
+//! written to the SSI FIFO.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RIT128x96x4CallbackSet(void (*pfnCallback)(void))
+{
+    g_pfnQueueCallback = pfnCallback;
+}
+
+//*****************************************************************************
+//
+//! Returns the transfer queue statistics.
+//!
+//! \param psStats points to the structure that receives the counters.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RIT128x96x4QueueStatsGet(tRIT128x96x4QueueStats *psStats)
+{
+    *psStats = g_sQueueStats;
+}
+
+//*****************************************************************************
+//
+//! Resets the transfer queue statistics.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RIT128x96x4QueueStatsClear(void)
+{
+    g_sQueueStats.ulBatches = 0;
+    g_sQueueStats.ulBytes = 0;
+    g_sQueueStats.ulMaxDepth = 0;
+    g_sQueueStats.ulFullWaits = 0;
+    g_sQueueStats.ulDeferrals = 0;
+}
+
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Pack one row of a character into the 2-bit codes of the glyph cache: one
+//! byte per pair of columns, bit 1 for the left pixel and bit 0 for the
+//! right one.  The sixth column is the blank spacing column.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+RITGlyphPack(unsigned long ulGlyph, unsigned long ulRow,
+             unsigned char *pucCodes)
+{
+    unsigned long ulIdx;
+    unsigned char ucCode;
+
+    for(ulIdx = 0; ulIdx < 6; ulIdx += 2)
+    {
+        ucCode = 0;
+        if(g_pucFont[ulGlyph][ulIdx] & (1 << ulRow))
+        {
+            ucCode = 2;
+        }
+        if((ulIdx < 4) && (g_pucFont[ulGlyph][ulIdx + 1] & (1 << ulRow)))
+        {
+            ucCode |= 1;
+        }
+        *pucCodes++ = ucCode;
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Compose one row of a string into \e pucRow in display format, three bytes
+//! per character, stopping after \e ulMaxBytes bytes.  Characters from the
+//! glyph cache are copied through the gray level table \e pucLevel; the
+//! others are packed from the font.
+//!
+//! \return Returns the number of bytes written.
+//
+//*****************************************************************************
+static unsigned long
+RITTextRowPack(const char *pcStr, unsigned long ulRow,
+               const unsigned char *pucLevel, unsigned char *pucRow,
+               unsigned long ulMaxBytes)
+{
+    unsigned char pucCodes[RIT_GLYPH_BYTES];
+    const unsigned char *pucGlyph;
+    unsigned long ulGlyph, ulIdx, ulCount;
+
+    ulCount = 0;
+    while((*pcStr != 0) && (ulCount < ulMaxBytes))
     {
         //
-        // Loop through the columns.  Each byte is two pixels,
-        // and the buffer hold 8 bytes, so 16 pixels are cleared
-        // at a time.
+        // Convert the character to an index into the character bit-map
+        // array.
         //
-        for(ulColumn = 0; ulColumn < 128; ulColumn += 8 * 2)
+        ulGlyph = *pcStr++ & 0x7f;
+        ulGlyph = (ulGlyph < ' ') ? 0 : (ulGlyph - ' ');
+
+        if(ulGlyph < RIT_GLYPH_CACHED)
+        {
+            pucGlyph = g_pucGlyphCache[ulGlyph][ulRow];
+        }
+        else
         {
-            //
-            // Write 8 clearing bytes to the display, which will
-            // clear 16 pixels across.
-            //
-            RITWriteData(g_pucBuffer, sizeof(g_pucBuffer));
+            RITGlyphPack(ulGlyph, ulRow, pucCodes);
+            pucGlyph = pucCodes;
+        }
+        for(ulIdx = 0; (ulIdx < RIT_GLYPH_BYTES) && (ulCount < ulMaxBytes);
+            ulIdx++)
+        {
+            pucRow[ulCount++] = pucLevel[pucGlyph[ulIdx]];
         }
     }
+    return(ulCount);
+}
+
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Build the glyph cache if it has not been built yet, and fill the gray
+//! level table for \e ucLevel: the display byte for each 2-bit code.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+RITTextSetup(unsigned char ucLevel, unsigned char *pucLevel)
+{
+    unsigned long ulGlyph, ulRow;
+
+    if(!g_bGlyphCacheValid)
+    {
+        for(ulGlyph = 0; ulGlyph < RIT_GLYPH_CACHED; ulGlyph++)
+        {
+            for(ulRow = 0; ulRow < RIT_GLYPH_ROWS; ulRow++)
+            {
+                RITGlyphPack(ulGlyph, ulRow, g_pucGlyphCache[ulGlyph][ulRow]);
+            }
+        }
+        g_bGlyphCacheValid = true;
+    }
+
+    pucLevel[0] = 0;
+    pucLevel[1] = (ucLevel << 0) & 0x0f;
+    pucLevel[2] = (ucLevel << 4) & 0xf0;
+    pucLevel[3] = pucLevel[1] | pucLevel[2];
 }
 
 //*****************************************************************************
@@ -497,7 +1121,8 @@ RIT128x96x4Clear(void)
 //! rows from the top edge of the display.
 //! \param ucLevel is the 4-bit gray scale value to be used for displayed text.
 //!
-//! This function will draw a string on the display.  Only the ASCII characters
+//! This function will draw a string in the off-screen frame; it appears on the
+//! display with the next RIT128x96x4Flush().  Only the ASCII characters
 //! between 32 (space) and 126 (tilde) are supported; other characters will
 //! result in random data being draw on the display (based on whatever appears
 //! before/after the font in memory).  The font is mono-spaced, so characters
@@ -519,8 +1144,8 @@ void
 RIT128x96x4StringDraw(const char *pcStr, unsigned long ulX,
                       unsigned long ulY, unsigned char ucLevel)
 {
-    unsigned long ulIdx1, ulIdx2;
-    unsigned char ucTemp;
+    unsigned char pucLevel[4];
+    unsigned long ulRow, ulCount;
 
     //
     // Check the arguments.
@@ -531,77 +1156,56 @@ RIT128x96x4StringDraw(const char *pcStr, unsigned long ulX,
     ASSERT(ucLevel < 16);
 
     //
-    // Setup a window starting at the specified column and row, ending
-    // at the right edge of the display and 8 rows down (single character row).
-    //
-    g_pucBuffer[0] = 0x15;
-    g_pucBuffer[1] = ulX / 2;
-    g_pucBuffer[2] = 63;
-    RITWriteCommand(g_pucBuffer, 3);
-    g_pucBuffer[0] = 0x75;
-    g_pucBuffer[1] = ulY;
-    g_pucBuffer[2] = ulY + 7;
-    RITWriteCommand(g_pucBuffer, 3);
-    RITWriteCommand(g_pucRIT128x96x4VerticalInc,
-                    sizeof(g_pucRIT128x96x4VerticalInc));
-
-    //
-    // Loop while there are more characters in the string.
+    // Compose the string one row at a time and copy each row into the
+    // off-screen frame as a single run.
     //
-    while(*pcStr != 0)
+    RITTextSetup(ucLevel, pucLevel);
+    for(ulRow = 0; ulRow < RIT_GLYPH_ROWS; ulRow++)
     {
-        //
-        // Get a working copy of the current character and convert to an
-        // index into the character bit-map array.
-        //
-        ucTemp = *pcStr++ & 0x7f;
-        if(ucTemp < ' ')
-        {
-            ucTemp = 0;
-        }
-        else
-        {
-            ucTemp -= ' ';
-        }
+        ulCount = RITTextRowPack(pcStr, ulRow, pucLevel, g_pucTextRow,
+                                 (128 - ulX) / 2);
+        RITFrameRowPut(ulY + ulRow, ulX / 2, g_pucTextRow, ulCount);
+    }
+}
 
-        //
-        // Build and display the character buffer.
-        //
-        for(ulIdx1 = 0; ulIdx1 < 6; ulIdx1 += 2)
-        {
-            //
-            // Convert two columns of 1-bit font data into a single data
-            // byte column of 4-bit font data.
-            //
-            for(ulIdx2 = 0; ulIdx2 < 8; ulIdx2++)
-            {
-                g_pucBuffer[ulIdx2] = 0;
-                if(g_pucFont[ucTemp][ulIdx1] & (1 << ulIdx2))
-                {
-                    g_pucBuffer[ulIdx2] = (ucLevel << 4) & 0xf0;
-                }
-                if((ulIdx1 < 4) &&
-                   (g_pucFont[ucTemp][ulIdx1 + 1] & (1 << ulIdx2)))
-                {
-                    g_pucBuffer[ulIdx2] |= (ucLevel << 0) & 0x0f;
-                }
-            }
+//*****************************************************************************
+//
+//! Renders a string into an image for RIT128x96x4ImageDraw().
+//!
+//! \param pcStr is a pointer to the string to render.
+//! \param ucLevel is the 4-bit gray scale value to be used for the text.
+//! \param pucImage is a pointer to the image buffer, which must hold at least
+//! RIT_TEXT_BYTES(n) bytes for a string of n characters.
+//!
+//! This function is meant for labels that are drawn over and over: the string
+//! is rasterized once, and each later RIT128x96x4ImageDraw() of the image
+//! only copies its rows into the off-screen frame.  The image is 8 rows high
+//! and six columns wide per character, in the format of
+//! RIT128x96x4ImageDraw(), and looks exactly like the same string drawn by
+//! RIT128x96x4StringDraw().  Strings wider than the display are cut at 128
+//! columns.
+//!
+//! \return Returns the width of the image in columns.
+//
+//*****************************************************************************
+unsigned long
+RIT128x96x4TextRender(const char *pcStr, unsigned char ucLevel,
+                      unsigned char *pucImage)
+{
+    unsigned char pucLevel[4];
+    unsigned long ulRow, ulCount;
 
-            //
-            // Send this byte column to the display.
-            //
-            RITWriteData(g_pucBuffer, 8);
-            ulX += 2;
+    ASSERT(ucLevel < 16);
 
-            //
-            // Return if the right side of the display has been reached.
-            //
-            if(ulX == 128)
-            {
-                return;
-            }
-        }
+    RITTextSetup(ucLevel, pucLevel);
+    ulCount = 0;
+    for(ulRow = 0; ulRow < RIT_GLYPH_ROWS; ulRow++)
+    {
+        ulCount = RITTextRowPack(pcStr, ulRow, pucLevel, pucImage,
+                                 RIT_COLUMN_BYTES);
+        pucImage += ulCount;
     }
+    return(ulCount * 2);
 }
 
 //*****************************************************************************
@@ -616,7 +1220,8 @@ RIT128x96x4StringDraw(const char *pcStr, unsigned long ulX,
 //! \param ulWidth is the width of the image, specified in columns.
 //! \param ulHeight is the height of the image, specified in rows.
 //!
-//! This function will display a bitmap graphic on the display.  Because of the
+//! This function will draw a bitmap graphic in the off-screen frame; it
+//! appears on the display with the next RIT128x96x4Flush().  Because of the
 //! format of the display RAM, the starting column (\e ulX) and the number of
 //! columns (\e ulWidth) must be an integer multiple of two.
 //!
@@ -680,35 +1285,21 @@ RIT128x96x4ImageDraw(const unsigned char *pucImage, unsigned long ulX,
     ASSERT((ulY + ulHeight) <= 96);
     ASSERT((ulWidth & 1) == 0);
 
-    //
-    // Setup a window starting at the specified column and row, and ending
-    // at the column + width and row+height.
-    //
-    g_pucBuffer[0] = 0x15;
-    g_pucBuffer[1] = ulX / 2;
-    g_pucBuffer[2] = (ulX + ulWidth - 2) / 2;
-    RITWriteCommand(g_pucBuffer, 3);
-    g_pucBuffer[0] = 0x75;
-    g_pucBuffer[1] = ulY;
-    g_pucBuffer[2] = ulY + ulHeight - 1;
-    RITWriteCommand(g_pucBuffer, 3);
-    RITWriteCommand(g_pucRIT128x96x4HorizontalInc,
-                    sizeof(g_pucRIT128x96x4HorizontalInc));
-
     //
     // Loop while there are more rows to display.
     //
     while(ulHeight--)
     {
         //
-        // Write this row of image data.
+        // Copy this row of image data into the off-screen frame.
         //
-        RITWriteData(pucImage, (ulWidth / 2));
+        RITFrameRowPut(ulY, ulX / 2, pucImage, ulWidth / 2);
 
         //
         // Advance to the next row of the image.
         //
         pucImage += (ulWidth / 2);
+        ulY++;
     }
 }
 
@@ -745,9 +1336,11 @@ RIT128x96x4Enable(unsigned long ulFrequency)
                      GPIO_PIN_TYPE_STD_WPU);
 
     //
-    // Enable the SSI port.
+    // Enable the SSI port and the interrupt that feeds it from the transfer
+    // queue.
     //
     SSIEnable(SSI0_BASE);
+    SSIIntRegister(SSI0_BASE, RITSSIIntHandler);
 
     //
     // Indicate that the RIT driver can use the SSI Port.
@@ -769,6 +1362,17 @@ RIT128x96x4Disable(void)
 {
     unsigned long ulTemp;
 
+    //
+    // Let the transfer queue and the FIFO drain.
+    //
+    while(RIT128x96x4Busy())
+    {
+        SysCtlSleep();
+    }
+    while(SSIBusy(SSI0_BASE))
+    {
+    }
+
     //
     // Indicate that the RIT driver can no longer use the SSI Port.
     //
@@ -1641,6 +2245,115 @@ char string[4];
   Int2Str2(num, string);
   RIT128x96x4StringDraw(string, ulX, ulY, ucLevel);
 }
+
+/****************DecStr, UDecStr, FloatStr, TextStr***************
+ allocation free replacements for sprintf("%d"), ("%lu"), ("%.nf")
+ and ("text"), for building the strings passed to
+ RIT128x96x4StringDraw() without the printf library
+ Unlike the functions above, the output is not padded: the number
+ takes as many characters as it needs, like with sprintf.  Each
+ function writes a null-terminated string and returns a pointer to
+ the null, so that the pieces of a line can be chained:
+    p = TextStr("ADC ", string);
+    p = FloatStr(x, 2, p);
+ DecStr: signed 32-bit fixed point number with decimals digits
+         after the point, 0 to 9 (decimals=0 for an integer)
+ FloatStr: float rounded to decimals digits (half away from zero),
+         "*" when the rounded value times 10^decimals may not fit in 32
+         bits
+ Examples
+  DecStr(-12345, 4, s) to "-1.2345"
+  DecStr(31, 2, s)     to "0.31"
+  UDecStr(1000, s)     to "1000"
+  FloatStr(0.0421, 4)  to "0.0421"
+  FloatStr(-3.14159, 2) to "-3.14"
+ */
+static char *DecDigits(unsigned long n, unsigned long const decimals, char *string){
+  char reversed[12];
+  unsigned long i=0;
+
+  ASSERT(decimals < 10);
+  do{                       // least significant digit first
+    reversed[i++] = '0'+n%10;
+    n = n/10;
+  } while((n!=0) || (i<=decimals)); // at least one digit before the point
+  while(i>0){
+    *string++ = reversed[--i];
+    if((i==decimals) && (i!=0)){
+      *string++ = '.';
+    }
+  }
+  *string = 0;
+  return string;
+}
+char *DecStr(long const num, unsigned long const decimals, char *string){
+  if(num<0){
+    *string++ = '-';
+    return DecDigits(-(unsigned long)num, decimals, string);
+  }
+  return DecDigits(num, decimals, string);
+}
+char *UDecStr(unsigned long const num, char *string){
+  return DecDigits(num, 0, string);
+}
+char *FloatStr(float x, unsigned long const decimals, char *string){
+  static const unsigned long Pow10[10] = {1, 10, 100, 1000, 10000, 100000,
+                                          1000000, 10000000, 100000000,
+                                          1000000000};
+  unsigned long ip;
+  float frac;
+
+  ASSERT(decimals < 10);
+  if(x<0){
+    *string++ = '-';
+    x = -x;
+  }
+  // the integer part is exact, so only the fraction is scaled in float;
+  // the bound on ip leaves room for a fraction that rounds up to a unit
+  if(!(x < 4294967296.0f) || // too big, or not a number
+     ((ip = (unsigned long)x) > (0xFFFFFFFFUL - Pow10[decimals])/Pow10[decimals])){
+    string[0] = '*';
+    string[1] = 0;
+    return string+1;
+  }
+  frac = (x-ip)*Pow10[decimals] + 0.5f;
+  return DecDigits(ip*Pow10[decimals] + (unsigned long)frac, decimals, string);
+}
+char *TextStr(const char *text, char *string){
+  while(*text){
+    *string++ = *text++;
+  }
+  *string = 0;
+  return string;
+}
+//*****************************************************************************
+//
+//! Displays a float on the OLED display.
+//!
+//! \param x is the number to display.
+//! \param decimals is the number of digits after the point, 0 to 9.
+//! \param ulX is the horizontal position to display the string, specified in
+//! columns from the left edge of the display.
+//! \param ulY is the vertical position to display the string, specified in
+//! rows from the top edge of the display.
+//! \param ucLevel is the 4-bit gray scale value to be used for displayed text.
+//!
+//! This function will display the number like sprintf("%.nf") would format
+//! it, see FloatStr().
+//!
+//! \note Because the OLED display packs 2 pixels of data in a single byte, the
+//! parameter \e ulX must be an even column number (for example, 0, 2, 4, and
+//! so on).
+//!
+//! \return None.
+//
+//*****************************************************************************
+void RIT128x96x4FloatOut(float x, unsigned long decimals, unsigned long ulX,
+                      unsigned long ulY, unsigned char ucLevel){
+char string[16];
+  FloatStr(x, decimals, string);
+  RIT128x96x4StringDraw(string, ulX, ulY, ucLevel);
+}
 //! Graphics plot, an image 128 columns wide and 80 scan lines tall would
 //! be arranged as follows (showing how the twenty one bytes of the image would
 //! appear on the display):
@@ -26,6 +26,33 @@
 #ifndef __RIT128X96X4_H__
 #define __RIT128X96X4_H__
 
+//*****************************************************************************
+//
+// Counters of the display transfer queue.  ulBatches and ulBytes count the
+// runs and bytes queued, ulMaxDepth is the deepest the queue has been,
+// ulFullWaits counts how often the drawing code had to wait for a free entry
+// and ulDeferrals how many times RIT128x96x4Flush() found the queue full and
+// had to finish the frame over the following calls.
+//
+//*****************************************************************************
+typedef struct
+{
+    unsigned long ulBatches;
+    unsigned long ulBytes;
+    unsigned long ulMaxDepth;
+    unsigned long ulFullWaits;
+    unsigned long ulDeferrals;
+}
+tRIT128x96x4QueueStats;
+
+//*****************************************************************************
+//
+// Size in bytes of the image of an n character string rendered by
+// RIT128x96x4TextRender(): 8 rows of 3 bytes per character.
+//
+//*****************************************************************************
+#define RIT_TEXT_BYTES(n)       ((n) * 24)
+
 //*****************************************************************************
 //
 // Prototypes for the driver APIs.
@@ -36,15 +63,53 @@ extern void RIT128x96x4StringDraw(const char *pcStr,
                                     unsigned long ulX,
                                     unsigned long ulY,
                                     unsigned char ucLevel);
+extern unsigned long RIT128x96x4TextRender(const char *pcStr,
+                                           unsigned char ucLevel,
+                                           unsigned char *pucImage);
 extern void RIT128x96x4ImageDraw(const unsigned char *pucImage,
                                    unsigned long ulX,
                                    unsigned long ulY,
                                    unsigned long ulWidth,
                                    unsigned long ulHeight);
+extern void RIT128x96x4FrameClear(void);
+extern void RIT128x96x4Flush(void);
+extern tBoolean RIT128x96x4Busy(void);
+extern tBoolean RIT128x96x4Pending(void);
+extern void RIT128x96x4CallbackSet(void (*pfnCallback)(void));
+extern void RIT128x96x4QueueStatsGet(tRIT128x96x4QueueStats *psStats);
+extern void RIT128x96x4QueueStatsClear(void);
 extern void RIT128x96x4Init(unsigned long ulFrequency);
 extern void RIT128x96x4Enable(unsigned long ulFrequency);
 extern void RIT128x96x4Disable(void);
 extern void RIT128x96x4DisplayOn(void);
 extern void RIT128x96x4DisplayOff(void);
 
+//*****************************************************************************
+//
+// Number formatting without the printf library.  Each function writes a
+// null-terminated string and returns a pointer to the null.
+//
+//*****************************************************************************
+extern char *DecStr(long const num, unsigned long const decimals,
+                    char *string);
+extern char *UDecStr(unsigned long const num, char *string);
+extern char *FloatStr(float x, unsigned long const decimals, char *string);
+extern char *TextStr(const char *text, char *string);
+extern void RIT128x96x4FloatOut(float x, unsigned long decimals,
+                                unsigned long ulX, unsigned long ulY,
+                                unsigned char ucLevel);
+
+//*****************************************************************************
+//
+// Plot of 108 points drawn in PlotImage and shown at (16,10) by
+// RIT128x96x4ShowPlot().
+//
+//*****************************************************************************
+extern void RIT128x96x4PlotClear(long ymin, long ymax, long y0, long y1,
+                                 long y2, long y3);
+extern void RIT128x96x4PlotReClear(void);
+extern void RIT128x96x4PlotPoint(long y);
+extern void RIT128x96x4PlotNext(void);
+extern void RIT128x96x4ShowPlot(void);
+
 #endif // __RIT128X96X4_H__
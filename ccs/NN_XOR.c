@@ -9,12 +9,19 @@
 #include "inc/hw_types.h"
 #include "driverlib/debug.h"
 #include "driverlib/sysctl.h"
+#include "driverlib/systick.h"
 #include "driverlib/interrupt.h"
 #include "driverlib/gpio.h"   // Defines and macros for GPIO API of DriverLib (GPIOPinTypePWM)
 #include "driverlib/adc.h"
+#include "driverlib/flash.h"
 #include "supervisedNN.h"
-#include "drivers/rit128x96x4.h" // Defines and macros for the OLED Display. 
-#include "stdio.h"
+#include "adcRing.h"
+#include "trainPlot.h"
+#include "profile.h"
+#include "weightStore.h"
+#include "schedule.h"
+#include "trainControl.h"
+#include "Drivers/rit128x96x4.h" // Defines and macros for the OLED Display. 
 
 
 /* In case that there is an incorrect parameter or library function in the API */
@@ -50,11 +57,24 @@ int flag2=0;
 float Inputs[NumIn+1];
 float Outputs[NumOut+1];
 float Hidden[NumHid+1];
+float BatchHidden[NumPat][NumHid+1];
+float BatchOutputs[NumPat][NumOut+1];
 
 float InWeights[NumIn+1][NumHid+1];
 float HidWeights[NumHid+1][NumOut+1];
+float InGrad[NumIn+1][NumHid+1];		// gradient sums for batch training
+float HidGrad[NumHid+1][NumOut+1];
 
 float eta = 0.1;
+short BatchSize = 1;	// patterns per weight update: 1 online, NumPat full batch
+short PatternMode = ORDER_FIXED;	// pattern order of each epoch: ORDER_FIXED, ORDER_SHUFFLE or ORDER_SAMPLE
+unsigned short PatternIndex[NumPat];	// patterns of the current epoch, set by PatternOrder()
+short OptimizerMethod = OPT_MOMENTUM;	// weight update rule, OPT_SGD... see bench_optim
+tOptimizer Optimizer;
+tOptArena OptimizerArena;
+long long OptimizerArenaMem[OPT_ARENA_BYTES((NumIn+1)*(NumHid+1)+(NumHid+1)*(NumOut+1), 2)/8+1];	// its per-weight state
+short ScheduleMode = SCHED_EXP;	// eta of each epoch, SCHED_CONSTANT... see bench_schedule
+tSchedule Schedule;
 
 float target[NumOut+1];
 float Bias[2]={-1, -1};
@@ -67,6 +87,130 @@ float array2[3][3] = {1,2,3,4,5,6,7,8,9};
 
 short targetFlag = 0;
 
+	/* Weights Initialization Seed */
+
+#ifndef NN_SEED
+#define NN_SEED 0		// 0 seeds the weights from the ADC noise at reset, any other value repeats a run
+#endif
+#define SEED_CONVERSIONS 64	// ADC conversions folded into the seed
+
+/* Seed of the current weights, volatile so it can be read from the watch
+* window and given back as NN_SEED (or written here before the weights are
+* initialized) to reproduce a run */
+volatile unsigned long NNSeed=NN_SEED;
+
+/* Initialization strategy of each layer, INIT_UNIFORM... see bench_init */
+short InWeightsMode = INIT_UNIFORM;
+short HidWeightsMode = INIT_UNIFORM;
+
+	/* Trained Weights in Flash (weightStore.h) */
+
+short SaveWeights=1;		// keep the weights in the flash store when a training converges
+short SavePending=0;		// converged while streaming, saved once the streaming stops
+short WeightsRestored=0;	// the weights at reset came from the flash store
+/* Cycles to find, check and load the stored weights at reset, volatile so
+* they can be read from the watch window */
+volatile unsigned long RestoreCycles=0;
+
+	/* Background Training Task */
+
+#define EPOCHS_PER_SLICE 50	// epochs trained between two checks of the posted commands
+
+volatile unsigned long Commands=0;	// buttons posted by IntGPIOg, handled in main()
+short Training=0;
+int TrainingEpoch=0;
+float TrainingError=100;
+
+#define TRAIN_MAX_EPOCHS 20000	// epoch budget of a training
+#define TRAIN_ERROR 0.05		// epoch error to reach
+#define TRAIN_PATIENCE 1000		// epochs without a 0.1% better error before giving up, see bench_control
+#define TRAIN_BUDGET_SECONDS 60	// training time budget, plot and commands not included
+tTrainControl TrainingControl;	// why the last training stopped, and its cycles per epoch
+
+/* Worst case execution time of the interrupt handlers in SysTick cycles. A
+* handler can delay another one by at most its own execution time, so the
+* largest one bounds the interrupt latency. Volatile so they can be
+* read from the watch window */
+volatile unsigned long ADCIntCyclesMax=0;
+volatile unsigned long GPIOIntCyclesMax=0;
+volatile unsigned long SysTickIntCyclesMax=0;
+
+	/* Live Training Error Curve */
+
+#ifndef PLOT_FRAME_TICKS
+#define PLOT_FRAME_TICKS 100	// SysTick ticks between two plot redraws, at most 10 frames/s
+#endif
+#ifndef PLOT_OVERHEAD
+#define PLOT_OVERHEAD 5		// plot redraws may cost at most this % of the training time
+#endif
+
+short TrainingPlot=1;		// draw the error curve while training
+tTrainPlot TrainingCurve;
+unsigned long PlotTick;		// SysTickCount at the last redraw
+
+/* Cycles spent training and redrawing the curve since the start of the
+* training (both halved together on long runs), and the number of redraws.
+* Volatile so they can be read from the watch window */
+volatile unsigned long TrainingCycles=0;
+volatile unsigned long PlotCycles=0;
+volatile unsigned long PlotFrames=0;
+
+	/* Streaming Inference on ADC ch0 and ch1 */
+
+#define SAMPLE_RATE 1000		// ADC sample pairs per second, SysTick triggers each conversion
+#define PUBLISH_SAMPLES 100		// samples between two updates of the results on the OLED
+#define ADC_FULL_SCALE 1023		// 10 bit converter
+#define ADC_INPUT_SCALE (0.9f/ADC_FULL_SCALE)	// sample to input step, folded by the compiler
+
+unsigned long SysTickPeriod;			// cycles per sample
+volatile unsigned long SysTickCount=0;	// SysTick interrupts since reset
+#define STREAM_BATCH 8			// frames taken from the ring per call of StreamTask()
+
+volatile unsigned long ADCTriggerTick;	// SysTickCount when the last conversion was triggered
+volatile unsigned long ADCOverflows=0;	// conversions lost in the sequencer FIFO
+tADCRing ADCRing;						// ADC1IntHandler -> StreamTask()
+short Streaming=0;
+
+/* Streaming statistics, volatile so they can be read from the watch window */
+volatile unsigned long StreamInferences=0;	// samples run through the network
+volatile unsigned long StreamStartTick;		// SysTickCount when streaming started
+volatile unsigned long StreamLatency=0;		// sample trigger to network output, in cycles
+volatile unsigned long StreamLatencyMax=0;
+volatile unsigned long StreamOverrunStart;	// ADCRing.Overruns when streaming started
+
+volatile unsigned long OLEDTransfers=0;	// OLED transfer queue drained into the SSI FIFO
+
+	/* Labels rasterized once by LabelsInit(), drawn with RIT128x96x4ImageDraw() */
+
+#define LABEL_HEIGHT 8
+
+unsigned char TrainingLabel[RIT_TEXT_BYTES(11)];
+unsigned char ResultsLabel[RIT_TEXT_BYTES(7)];
+unsigned char InputsLabel[RIT_TEXT_BYTES(6)];
+unsigned char EqualsLabel[RIT_TEXT_BYTES(1)];
+unsigned long TrainingLabelWidth, ResultsLabelWidth, InputsLabelWidth, EqualsLabelWidth;
+
+	/* Profiling scopes, compiled in with PROFILE (see profile.h) */
+
+#define PROF_FORWARD 0		// Forward(), streaming and sampled by ProfileSample()
+#define PROF_BACKPROP 1		// BackPropagation(), sampled
+#define PROF_EPOCH 2		// TrainEpoch() while training
+#define PROF_STRING 3		// RIT128x96x4StringDraw() of a number, sampled
+#define PROF_PLOT 4			// training curve redraw and flush
+#define PROF_SCOPES 5
+
+#ifdef PROFILE
+#define PROFILE_SAMPLES 16	// calls timed per scope by ProfileSample()
+
+const char * const ProfileNames[PROF_SCOPES] = {"Fwd", "Back", "Epoch", "Str", "Plot"};
+
+/* scratch network, so that sampling does not disturb the trained one */
+float ProfInWeights[NumIn+1][NumHid+1];
+float ProfHidWeights[NumHid+1][NumOut+1];
+float ProfHidden[NumHid+1];
+float ProfOutputs[NumOut+1];
+#endif
+
 /******************************************************************************/
 /**** Erase the specified row in the OLED                                     */
 void RIT128x96x4StringErase(int row)
@@ -75,45 +219,399 @@ void RIT128x96x4StringErase(int row)
 }	
 
 
+/******************************************************************************/
+/**** Rasterize the static labels                                            */
+void LabelsInit(void)
+{
+	TrainingLabelWidth = RIT128x96x4TextRender("Training...", 15, TrainingLabel);
+	ResultsLabelWidth = RIT128x96x4TextRender("Results", 15, ResultsLabel);
+	InputsLabelWidth = RIT128x96x4TextRender("Inputs", 15, InputsLabel);
+	EqualsLabelWidth = RIT128x96x4TextRender("=", 15, EqualsLabel);
+}
+
+#ifdef PROFILE
+/******************************************************************************/
+/**** Time the functions that are not profiled where they run, on a copy of  */
+/**** the network and on the bottom row of the screen.                       */
+void ProfileSample(void)
+{
+	float	in[NumIn+1];
+	short	i,n;
+
+	for (n=0;n<=NumIn;n++) {
+		for (i=0;i<=NumHid;i++) ProfInWeights[n][i]=InWeights[n][i];
+	}
+	for (n=0;n<=NumHid;n++) {
+		for (i=0;i<=NumOut;i++) ProfHidWeights[n][i]=HidWeights[n][i];
+	}
+	in[0]=Bias[0];
+	ProfHidden[0]=Bias[1];
+
+	for (n=0;n<PROFILE_SAMPLES;n++) {
+		in[1]=XORInputs[n%NumPat][0];
+		in[2]=XORInputs[n%NumPat][1];
+		target[1]=XORTarget[n%NumPat];
+		PROFILE_BEGIN(PROF_FORWARD);
+		Forward(in, ProfInWeights, ProfHidden, ProfHidWeights, ProfOutputs);
+		PROFILE_END(PROF_FORWARD);
+		PROFILE_BEGIN(PROF_BACKPROP);
+		BackPropagation(target, in, ProfInWeights, ProfHidden, ProfHidWeights, ProfOutputs, eta);
+		PROFILE_END(PROF_BACKPROP);
+		PROFILE_BEGIN(PROF_STRING);
+		RIT128x96x4StringDraw((n&1) ? "0.1234" : "-5.678", 0, 88, 10);
+		PROFILE_END(PROF_STRING);
+	}
+	RIT128x96x4StringErase(88);
+}
+
+/******************************************************************************/
+/**** Profile value in at most 5 characters                                   */
+char *ProfileValueStr(unsigned long value, char *string)
+{
+	if (value < 100000) return UDecStr(value, string);
+	if (value < 10000000) return TextStr("k", UDecStr(value/1000, string));
+	return TextStr("M", UDecStr(value/1000000, string));
+}
+
+/******************************************************************************/
+/**** Table of the profiling scopes from row y: min, mean and max            */
+void ProfileDraw(unsigned long y)
+{
+	char	str[16];
+	short	n;
+
+	RIT128x96x4StringDraw(PROFILE_UNIT, 0, y, 15);
+	RIT128x96x4StringDraw("min", 26, y, 15);
+	RIT128x96x4StringDraw("mean", 60, y, 15);
+	RIT128x96x4StringDraw("max", 94, y, 15);
+	for (n=0;n<PROF_SCOPES;n++) {
+		y += 8;
+		RIT128x96x4StringDraw(ProfileScopes[n].Name, 0, y, 10);
+		ProfileValueStr(ProfileScopes[n].Min, str);
+		RIT128x96x4StringDraw(str, 26, y, 10);
+		ProfileValueStr(ProfileMean(n), str);
+		RIT128x96x4StringDraw(str, 60, y, 10);
+		ProfileValueStr(ProfileScopes[n].Max, str);
+		RIT128x96x4StringDraw(str, 94, y, 10);
+	}
+}
+#endif
+
 /******************************************************************************/
 /**** Erase the all the screen                                                */
 void RIT128x96x4ScreenErase()
 {
-	int i;
-	for(i=0;i<60;i++)
+	RIT128x96x4FrameClear();	// blanked on the OLED by the next flush
+}
+/******************************************************************************/
+/**** SysTick cycles elapsed since start (a SysTickValueGet() reading), for  */
+/**** intervals shorter than one SysTick period.                             */
+unsigned long SysTickElapsed(unsigned long start)
+{
+	unsigned long now = SysTickValueGet();
+
+	/* SysTick counts down and reloads with SysTickPeriod-1 */
+	return (start >= now) ? (start - now) : (start + SysTickPeriod - now);
+}
+
+/******************************************************************************/
+/**** SysTick cycles elapsed since the beginning of the SysTick tick.       */
+unsigned long SysTickCyclesSince(unsigned long tick)
+{
+	unsigned long count, value;
+
+	do {	/* read the counter and the tick count of the same period */
+		count = SysTickCount;
+		value = SysTickValueGet();
+	} while (count != SysTickCount);
+	return (count - tick) * SysTickPeriod + (SysTickPeriod - 1 - value);
+}
+
+/******************************************************************************/
+/**** Free running cycle count, wraps after 2^32 cycles (214 s at 20 MHz).   */
+/**** Differences of two readings are valid across the wrap.                */
+unsigned long CycleCount(void)
+{
+	return SysTickCyclesSince(0);
+}
+
+/******************************************************************************/
+/**** SysTick Interruption Handler, samples ADC ch0 and ch1 at SAMPLE_RATE   */
+void SysTickIntHandler(void)
+{
+	unsigned long start = SysTickValueGet();
+	unsigned long cycles;
+
+	SysTickCount++;
+	ADCTriggerTick = SysTickCount;
+
+	   /* Trigger ADC Conversion */
+	ADCProcessorTrigger(ADC0_BASE,1);
+
+	cycles = SysTickElapsed(start);
+	if (cycles > SysTickIntCyclesMax) SysTickIntCyclesMax = cycles;
+}
+
+/******************************************************************************/
+/**** Seed from the ADC noise: the LSBs of ch0 and ch1 are never stable, so
+* folding a few conversions gives another seed at every reset. Polled, before
+* the ADC interrupt is enabled. 0 is kept for "no seed given"               */
+unsigned long ADCNoiseSeed(void)
+{
+	unsigned long samples[4];
+	unsigned long seed=0;
+	short n;
+	
+	for (n=0;n<SEED_CONVERSIONS;n++)
 	{
-		RIT128x96x4StringErase(i);
+		ADCProcessorTrigger(ADC0_BASE,1);
+		while (!ADCIntStatus(ADC0_BASE,1,false))
+		{
+		}
+		ADCSequenceDataGet(ADC0_BASE,1,samples);
+		ADCIntClear(ADC0_BASE,1);
+		seed = PRNGMix(seed, samples[0] | (samples[1]<<10));
 	}
-
+	return (seed ? seed : 1);
 }
+
 /******************************************************************************/
 /**** ADC Interruption Handler                                                */
 void ADC1IntHandler(void)
 {
+	unsigned long start = SysTickValueGet();
+	unsigned long cycles;
+	unsigned long samples[4];
+
 		/* Clear conversion complete flag */
 	ADCIntClear(ADC0_BASE, 1);
 	
-	/* Read the ADC value */
-	ADCSequenceDataGet(ADC0_BASE, 1, ulADC0Value);
-		
-	   /* Trigger ADC Conversion */
-	ADCProcessorTrigger(ADC0_BASE,1);
+	/* Count the conversions lost because the FIFO was not read in time */
+	if (ADCSequenceOverflow(ADC0_BASE, 1))
+	{
+		ADCOverflows++;
+		ADCSequenceOverflowClear(ADC0_BASE, 1);
+	}
+	
+	/* Read the ADC value and queue it with its trigger time */
+	ADCSequenceDataGet(ADC0_BASE, 1, samples);
+	ADCRingPut(&ADCRing, ADCTriggerTick, samples);
+
+	cycles = SysTickElapsed(start);
+	if (cycles > ADCIntCyclesMax) ADCIntCyclesMax = cycles;
+}
+
+
+/******************************************************************************/
+/**** OLED transfer queue emptied, called from the SSI interrupt             */
+void OLEDTransferDone(void)
+{
+	OLEDTransfers++;
 }
 
 
 /******************************************************************************/
-/**** This is the handler for INT_GPIOC.  It triggers INT_GPIOB and saves the */
-/**** interrupt sequence number. 											  */
+/**** GPIO Port G Interruption Handler. Only posts the pressed buttons, the  */
+/**** commands are executed by main() so that no interrupt is blocked.       */
 void IntGPIOg(void)
-{	
-	char	str[256];
-	int epoch=0;
-	float error=100;
-	short	i,j,k,cent,v,n;
-	
-	long int Status = GPIOPinIntStatus(GPIO_PORTG_BASE, true);
+{
+	unsigned long start = SysTickValueGet();
+	unsigned long cycles;
+
+	Commands |= GPIOPinIntStatus(GPIO_PORTG_BASE, true);
+ 	GPIOPinIntClear(GPIO_PORTG_BASE, GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7);
+
+	cycles = SysTickElapsed(start);
+	if (cycles > GPIOIntCyclesMax) GPIOIntCyclesMax = cycles;
+}
+
+
+/******************************************************************************/
+/**** Error over all the patterns, without training                          */
+float PatternsError(void)
+{
+	float e, error=0;
+	short i;
+
+	ForwardBatch(XORInputs, NumPat, Bias[0], Bias[1], InWeights, BatchHidden, HidWeights, BatchOutputs);
+	for (i=0;i<NumPat;i++)
+	{
+		e = XORTarget[i]-BatchOutputs[i][1];
+		error += 0.5f*e*e;
+	}
+	return error;
+}
+
+/******************************************************************************/
+/**** Saves the weights of a converged training once the streaming is       */
+/**** stopped: the flash erase stalls the CPU for milliseconds, long enough  */
+/**** for the ADC frames to overflow the FIFO and the ring.                  */
+void SaveTask(void)
+{
+	if (SavePending && !Streaming) {
+		SavePending=0;
+		WeightStoreSave(InWeights, HidWeights, TrainingEpoch, TrainingError);
+	}
+}
+
+/******************************************************************************/
+/**** Training slice: advances the training by at most EPOCHS_PER_SLICE      */
+/**** epochs and returns, so main() can serve the posted commands.           */
+void TrainingTask(void)
+{
+	char	str[32];
+	char	*p;
+	short	n;
+	unsigned long start;
+	unsigned long epochStart;
+
+	start=CycleCount();
+	n=0;
+	while ((TrainingControl.Reason==STOP_NONE) && (n<EPOCHS_PER_SLICE)) {   /* until the controller stops it */
+		epochStart=CycleCount();
+		TrainingEpoch++;  // new epoch
+		PROFILE_BEGIN(PROF_EPOCH);
+		PatternOrder(PatternIndex, NumPat, PatternMode);
+		TrainingError=TrainEpochOpt(XORInputs, XORTarget, PatternIndex, NumPat, BatchSize, Bias[0], Bias[1], InWeights, HidWeights, InGrad, HidGrad, &Optimizer);
+		if ((PatternMode==ORDER_SAMPLE) && (TrainingError<=TrainingControl.ErrorThreshold)) {
+			// a sampled epoch may have missed a pattern, check all of them
+			TrainingError=PatternsError();
+		}
+		OptimizerSetEta(&Optimizer, ScheduleUpdate(&Schedule, TrainingError));
+		PROFILE_END(PROF_EPOCH);
+		TrainControlEpoch(&TrainingControl, TrainingError, CycleCount()-epochStart);
+		if (TrainingPlot) TrainPlotAdd(&TrainingCurve, TrainingError);
+		n++;
+	}
+	TrainingCycles += CycleCount()-start;
+	if (TrainingCycles & 0x80000000) {	// long run: keep the ratio, not the totals
+		TrainingCycles /= 2;
+		PlotCycles /= 2;
+	}
+	if (TrainingControl.Reason==STOP_NONE) {
+		/* redraw the curve if the frame rate and the overhead budget allow it */
+		if (TrainingPlot && (SysTickCount-PlotTick >= PLOT_FRAME_TICKS) &&
+			(PlotCycles <= TrainingCycles/100*PLOT_OVERHEAD)) {
+			start=CycleCount();
+			PROFILE_BEGIN(PROF_PLOT);
+			TrainPlotDraw(&TrainingCurve);
+			RIT128x96x4Flush();		// what does not fit in the queue goes in the main loop
+			PROFILE_END(PROF_PLOT);
+			PlotCycles += CycleCount()-start;
+			PlotTick=SysTickCount;
+			PlotFrames++;
+		}
+		return;		// not finished, continue in the next slice
+	}
+	Training=0;
 	
-		// test the multiplication for the arrays. 
+	if (SaveWeights && (TrainingControl.Reason==STOP_CONVERGED)) {
+		SavePending=1;
+		SaveTask();		// now, or when a button stops the streaming
+	}
+
+	if (TrainingPlot) {
+		/* final curve, and the stop reason and result in the title row */
+		TrainPlotDraw(&TrainingCurve);
+		p = TextStr(TrainControlReason(TrainingControl.Reason), str);
+		p = TextStr(" ", p);
+		p = FloatStr(TrainingError, 4, p);
+		p = TextStr(" : ", p);
+		DecStr(TrainingEpoch, 0, p);
+		RIT128x96x4StringErase(0);
+		RIT128x96x4StringDraw(str, 2,  0, 15);
+		return;
+	}
+
+	RIT128x96x4StringDraw("Final Error: ", 2,  10, 10);
+	FloatStr(TrainingError, 4, str);
+	RIT128x96x4StringDraw(str, 20,  10, 10);
+	RIT128x96x4StringDraw(":", 25,  10, 10);
+
+	DecStr(TrainingEpoch, 0, str);
+	RIT128x96x4StringDraw(str, 30,  10, 10);
+
+	if (TrainingControl.Reason==STOP_CONVERGED) {
+		RIT128x96x4StringDraw("Training Finished", 30,  50, 15);
+	}
+	else {
+		p = TextStr("Stopped: ", str);
+		TextStr(TrainControlReason(TrainingControl.Reason), p);
+		RIT128x96x4StringDraw(str, 30,  50, 15);
+	}
+}
+
+
+/******************************************************************************/
+/**** Streaming inference: runs the queued ADC frames through the network   */
+/**** and publishes the result every PUBLISH_SAMPLES samples.                */
+void StreamTask(void)
+{
+	char	str[32];
+	char	*p;
+	tADCFrame frames[STREAM_BATCH];
+	unsigned long n, count, ticks, latency;
+
+	count = ADCRingRead(&ADCRing, frames, STREAM_BATCH);
+	for (n=0;n<count;n++)
+	{
+		/* Normalize the 10 bit samples to the 0.1..1.0 range of the training patterns */
+		Inputs[0]= Bias[0];
+		Inputs[1]= 0.1f + ADC_INPUT_SCALE*frames[n].Sample[0];
+		Inputs[2]= 0.1f + ADC_INPUT_SCALE*frames[n].Sample[1];
+		Hidden[0]= Bias[1];
+		PROFILE_BEGIN(PROF_FORWARD);
+		Forward(Inputs, InWeights, Hidden, HidWeights, Outputs);
+		PROFILE_END(PROF_FORWARD);
+
+		latency = SysTickCyclesSince(frames[n].Tick);
+		StreamLatency = latency;
+		if (latency > StreamLatencyMax) StreamLatencyMax = latency;
+		StreamInferences++;
+
+		if ((StreamInferences % PUBLISH_SAMPLES) == 0)
+		{
+			p = TextStr("ADC ", str);
+			p = FloatStr(Inputs[1], 2, p);
+			p = TextStr(" ", p);
+			p = FloatStr(Inputs[2], 2, p);
+			p = TextStr(" = ", p);
+			FloatStr(Outputs[1], 2, p);
+			RIT128x96x4StringDraw(str, 0,  60, 15);
+
+			/* inferences per second and worst sample to output latency */
+			ticks = SysTickCount - StreamStartTick;
+			p = UDecStr(StreamInferences*SAMPLE_RATE/(ticks ? ticks : 1), str);
+			p = TextStr("/s ", p);
+			p = UDecStr(StreamLatencyMax/(SysTickPeriod*SAMPLE_RATE/1000000), p);
+			TextStr("us   ", p);
+			RIT128x96x4StringDraw(str, 0,  70, 10);
+
+			/* frames dropped on a full ring and conversions lost in the FIFO */
+			p = TextStr("lost ", str);
+			p = UDecStr(ADCRing.Overruns-StreamOverrunStart, p);
+			p = TextStr(" ovf ", p);
+			p = UDecStr(ADCOverflows, p);
+			TextStr("   ", p);
+			RIT128x96x4StringDraw(str, 0,  80, 10);
+		}
+	}
+}
+
+
+/******************************************************************************/
+/**** Executes the command of one button. Status is the pin of the button.  */
+void ProcessCommand(long int Status)
+{
+	char	str[32];
+	short	i,j,k;
+
+	// any other button stops the streaming inference started by down,
+	// and a save it held back runs before the command changes anything
+	Streaming = 0;
+	SaveTask();
+
+	// test the multiplication for the arrays. 
   		if ( Status == 0x80) // select 
   		{
   			test(array1,array2,4);
@@ -121,11 +619,16 @@ void IntGPIOg(void)
 			for (i=1;i<3;i++){
 				for (j=0;j<3;j++){
 					// convert the numbers to string. 
-					sprintf(str, "%.4f", array2[i][j]);
+					FloatStr(array2[i][j], 4, str);
 					// display the number 
 					RIT128x96x4StringDraw(str, 10,  i*10, 15);
 				}
 			}
+#ifdef PROFILE
+			// and the profiling table below
+			ProfileSample();
+			ProfileDraw(32);
+#endif
 		}
 		
 		// Changes the output target to a AND
@@ -139,7 +642,7 @@ void IntGPIOg(void)
 				XORTarget[1] =0.1;
 				XORTarget[2] =0.1;
 				XORTarget[3] =1.0;
-				epoch=0;					
+				TrainingEpoch=0;					
 				targetFlag = 1;
 				break;
 				}
@@ -147,7 +650,7 @@ void IntGPIOg(void)
 		// Changes the output target to an OR		
 				case 1 :
 				{
-				epoch=0;	
+				TrainingEpoch=0;	
 				XORTarget[0] = 0.1;
 				XORTarget[1] =1.0;
 				XORTarget[2] =1.0;
@@ -159,7 +662,7 @@ void IntGPIOg(void)
 		// Changes the output target to a XOR			
 				case 2: 
 				{
-				epoch=0;	
+				TrainingEpoch=0;	
 				XORTarget[0] = 1.0;
 				XORTarget[1] =0.1;
 				XORTarget[2] =0.1;
@@ -168,6 +671,7 @@ void IntGPIOg(void)
 				break;
 				}
 			}
+			TrainControlStart(&TrainingControl);	// limits and patience count for the new target
 		}
 		
 		// display the weights				
@@ -179,7 +683,7 @@ void IntGPIOg(void)
 			for(j=0;j<=NumHid;j++){
 				for(i=0;i<=NumIn;i++){	
 					
-					sprintf( str, "%.4f", InWeights[i][j] );
+					FloatStr(InWeights[i][j], 4, str);
 					// display the number 
 					RIT128x96x4StringDraw(str, (i*8), (j+1)*8, 10);
 				}
@@ -190,116 +694,72 @@ void IntGPIOg(void)
 					
 			for(k=0;k<=NumOut;k++){
 				for(j=0;j<=NumHid;j++){
-					sprintf( str, "%.4f", HidWeights[j][k] );
+					FloatStr(HidWeights[j][k], 4, str);
 					// display the number 
 					RIT128x96x4StringDraw(str, (i*8), (j+NumHid)*8, 10);
 				}
 			}
 		}
 			
-		// Start Training. 		
+		// Start Training, the epochs run in TrainingTask()
 		if (Status == 0x08) // up
 		{	
 			RIT128x96x4ScreenErase();	
-			/*	training();*/
-		    /*******************************************************************************/		
 			// display title
-			RIT128x96x4StringDraw("Training...", 2,  0, 15);
-			error=100;  // error init;
-			n=1;
-			cent=0;
-			//for (n=0;n<1000;n++){
-			while ((error>0.05) || (epoch>20000)) {   /* do the loop until error< 0.05 or epoch > 5000*/
-				//if (epoch>1000){
-				//	n=0;
-				//}
-				//if (error<0.05){
-				//	n=0;
-				//} 
-				//else {	
-				epoch++;  // new epoch	
-				error=0;
-				for (i=0;i<NumPat;i++)
-				{  // present the patterns
-					j=i;
-					Inputs[0]= Bias[0];
-					Inputs[1]= XORInputs[j][0];
-					Inputs[2]= XORInputs[j][1];
-					Hidden[0]= Bias[1];
-					target[1]= XORTarget[j];			
-					Forward(Inputs, InWeights, Hidden, HidWeights, Outputs);		
-					error += 0.5*(target[1]-Outputs[1])*(target[1]-Outputs[1]);  // calculates the total error for the epoch
-					if (epoch>=cent)
-					{
-						v=j/1;
-
-					}		
-					BackPropagation(target,Inputs,InWeights,Hidden,HidWeights, Outputs, eta);	
-				}
-				if (epoch>=cent)
-				{
-					// display title
-					//RIT128x96x4StringDraw("Final Error: ", 2,  10, 15);			
-					v=epoch;
-					//sprintf( str, "%.4f", error );
-					//RIT128x96x4StringDraw(str, 20,  10, 15);
-					//RIT128x96x4StringDraw(":", 2,  10, 15);
-					
-					//sprintf( str, "%.4f", v );	
-			        //RIT128x96x4StringDraw(str, 30,  10, 15);
-					cent+=500;
-				}	
-			
-	//	}
+			RIT128x96x4ImageDraw(TrainingLabel, 2, 0, TrainingLabelWidth, LABEL_HEIGHT);
+			TrainingError=100;  // error init;
+			TrainingEpoch=0;
+			Training=1;
+			Optimizer.Eta=eta;
+			OptimizerReset(&Optimizer);	// no velocity left from the last training
+			ScheduleReset(&Schedule, eta);
+			TrainControlStart(&TrainingControl);
+			TrainingCycles=0;
+			PlotCycles=0;
+			PlotFrames=0;
+			if (TrainingPlot) {
+				TrainPlotInit(&TrainingCurve);	// axis labels, the curve follows
+				PlotTick=SysTickCount;
 			}
-			RIT128x96x4StringDraw("Final Error: ", 2,  10, 10);			
-			v=epoch;
-			sprintf( str, "%.4f", error );
-			RIT128x96x4StringDraw(str, 20,  10, 10);
-			RIT128x96x4StringDraw(":", 25,  10, 10);
-					
-			sprintf( str, "%.4f", v );	
-	        RIT128x96x4StringDraw(str, 30,  10, 10);
-	        
-	        RIT128x96x4StringDraw("Training Finished", 30,  50, 15);
-	
 		}
 		
 		// Run the Neural Network
 		if (Status == 0x10) // down 
 		{
 			RIT128x96x4ScreenErase();
+			ForwardBatch(XORInputs, NumPat, Bias[0], Bias[1], InWeights, BatchHidden, HidWeights, BatchOutputs);
+			RIT128x96x4ImageDraw(ResultsLabel, 60, 0, ResultsLabelWidth, LABEL_HEIGHT);
+			RIT128x96x4ImageDraw(InputsLabel, 10, 0, InputsLabelWidth, LABEL_HEIGHT);
 			for (i=0;i<NumPat;i++)
 			{
 				Inputs[0]= Bias[0];
 				Inputs[1]= XORInputs[i][0];
 				Inputs[2]= XORInputs[i][1];
 				target[1]=XORTarget[i];
-
-		        RIT128x96x4StringDraw("Results", 60,  0, 15);
-				RIT128x96x4StringDraw("Inputs", 10,  0, 15);
 						
-				sprintf( str, "%.2f", Inputs[1]);
+				FloatStr(Inputs[1], 2, str);
 			    RIT128x96x4StringDraw(str, 0,  10*i+10, 15);
 				
-				sprintf( str, "%.2f", Inputs[2]);
+				FloatStr(Inputs[2], 2, str);
 				RIT128x96x4StringDraw(str, 30,  10*i+10, 15);
 				
-				RIT128x96x4StringDraw("=", 55,  10*i+10, 15);
+				RIT128x96x4ImageDraw(EqualsLabel, 54, 10*i+10, EqualsLabelWidth, LABEL_HEIGHT);
 					
-				Hidden[0]= Bias[1];
-						
-				Forward(Inputs, InWeights, Hidden, HidWeights, Outputs);
-											
-				sprintf( str, "%.2f", Outputs[1]);
+				FloatStr(BatchOutputs[i][1], 2, str);
 				RIT128x96x4StringDraw(str, 65,  10*i+10, 15);
 				
-				sprintf( str, "%.2f", target[1]);
+				FloatStr(target[1], 2, str);
 			    RIT128x96x4StringDraw(str, 95,  10*i+10, 15);
 			}
+			
+			// then keep running the network on the ADC inputs
+			StreamInferences=0;
+			StreamLatencyMax=0;
+			StreamStartTick=SysTickCount;
+			StreamOverrunStart=ADCRing.Overruns;
+			ADCRingFlush(&ADCRing);
+			Streaming=1;
 		}
-	
- 	GPIOPinIntClear(GPIO_PORTG_BASE, GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7);
 }
 
 
@@ -316,6 +776,9 @@ int main(void)
 	long	para;
 	 char	str[256];
 	unsigned long tmp;
+	unsigned long cmd;
+	unsigned long bit;
+	short	busy;
 
 	long int outputint=0;
 	
@@ -325,7 +788,6 @@ int main(void)
 	int errorint=0;
 	short n=1;  // main training loop
 	//short i=0;  // pattern loop
-	short t=0;  // counter for the random pattern selector.
 	short j=0;  // general counter
 	//char str[10];
 	short cent=0;
@@ -334,6 +796,9 @@ int main(void)
 	/* Set the system Clock from the PLL to 20MHz (SYSCTL_SYSDIV_10) */
 	SysCtlClockSet(SYSCTL_SYSDIV_10 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_8MHZ);
 	
+	/* Flash program and erase timing for the weight store, clocks per us */
+	FlashUsecSet(SysCtlClockGet()/1000000);
+	
 	/***************************** IO Configuration */
 	
 	/* The clock should be enabled for the peripheral RCGCn register */
@@ -369,6 +834,13 @@ int main(void)
 	/* Reload the sequencer */
 	ADCSequenceEnable(ADC0_BASE, 1);
 	
+	/* Seed the weights initialization from the ADC noise unless a seed was given */
+	if (NNSeed==0)
+	{
+		NNSeed = ADCNoiseSeed();
+	}
+	PRNGSeed(&NNRandom, NNSeed);
+	
 	/***************************** Interruption Configuration*/
 	/* General Enable Interruptions */
 	IntMasterEnable();
@@ -394,19 +866,94 @@ int main(void)
 	/* Enable Port G.3 and Port G.4 for interruption */
 	GPIOPinIntEnable(GPIO_PORTG_BASE, GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_7);
 	
-	/* Trigger ADC Conversion */
-	ADCProcessorTrigger(ADC0_BASE,1);
+	/* Empty sample ring before the first conversion */
+	ADCRingInit(&ADCRing);
+	
+	/* SysTick at SAMPLE_RATE, it triggers the ADC conversions and times the handlers */
+	SysTickPeriod = SysCtlClockGet()/SAMPLE_RATE;
+	SysTickPeriodSet(SysTickPeriod);
+	SysTickIntRegister(SysTickIntHandler);
+	SysTickEnable();
 	
 	/* Init the OLED screen */
 	RIT128x96x4Init(1000000);
+	RIT128x96x4CallbackSet(OLEDTransferDone);
+	LabelsInit();
+#ifdef PROFILE
+	ProfileInit(ProfileNames, PROF_SCOPES);
+#endif
 	
-	/* Initialize the weights  */
-	InWeightsInit(InWeights);// init weights
-	HidWeightsInit(HidWeights);	
+	/* Initialize the weights: the last trained ones if the flash store has
+	* them, so the network can run at once, otherwise random ones */
+	tmp = CycleCount();
+	if (WeightStoreLoad(InWeights, HidWeights)==0)
+	{
+		WeightsRestored=1;
+	}
+	else
+	{
+		InWeightsInitMode(InWeights, InWeightsMode);// init weights
+		HidWeightsInitMode(HidWeights, HidWeightsMode);	
+	}
+	RestoreCycles = CycleCount()-tmp;
 	
+	/* Optimizer of the training, its state in the static arena */
+	OptArenaInit(&OptimizerArena, OptimizerArenaMem, sizeof(OptimizerArenaMem));
+	OptimizerInit(&Optimizer, OptimizerMethod, eta, 0);
+	if (OptimizerWeights(&Optimizer, &OptimizerArena) != 0)
+	{
+		/* The arena cannot hold the state of this method: train with plain
+		* SGD, which keeps none, rather than with state never set up */
+		OptimizerMethod = OPT_SGD;
+		OptimizerInit(&Optimizer, OptimizerMethod, eta, 0);
+		RIT128x96x4StringDraw("Optimizer: SGD", 2, 88, 15);
+	}
+	ScheduleInit(&Schedule, ScheduleMode, eta);
+	TrainControlInit(&TrainingControl, TRAIN_MAX_EPOCHS, TRAIN_ERROR, TRAIN_PATIENCE, SysCtlClockGet()*TRAIN_BUDGET_SECONDS);
+	if (WeightsRestored)
+	{
+		RIT128x96x4StringDraw("Trained weights", 2, 0, 10);
+	}
+	
+	/* Background loop: serve the commands posted by the button handler, run
+	* the network on each new ADC sample while streaming, train one slice at a
+	* time and sleep when there is nothing left to do */
 	while (1)
 	{
-  		
+		IntMasterDisable();
+		cmd = Commands;
+		Commands = 0;
+		IntMasterEnable();
+		
+		for (bit=0x08;bit<=0x80;bit<<=1)
+		{
+			if (cmd & bit)
+			{
+				ProcessCommand(bit);
+			}
+		}
+		
+		busy = 1;
+		if (Streaming && ADCRingCount(&ADCRing))
+		{
+			StreamTask();
+		}
+		else if (Training)
+		{
+			TrainingTask();
+		}
+		else
+		{
+			busy = 0;
+		}
+		
+		/* Send what the commands and the tasks drew to the OLED */
+		RIT128x96x4Flush();
+		
+		if (!busy)
+		{
+			SysCtlSleep();
+		}
 	}
 }
 
@@ -0,0 +1,51 @@
+/*****************************************************************************************/
+/* ADC sample ring                                                                       */
+/*                                                                                       */
+/* Consumer side of the single producer / single consumer ring in adcRing.h.             */
+/*****************************************************************************************/
+
+#include "adcRing.h"
+
+/*******************************************************/
+/*  Empty ring, before the producer is started         */
+/*******************************************************/
+
+void ADCRingInit(tADCRing *ring){
+	ring->Head = 0;
+	ring->Tail = 0;
+	ring->Overruns = 0;
+}
+
+/*******************************************************/
+/*  Copy up to maxFrames of the oldest frames out of   */
+/*  the ring.  Returns the number of frames read.      */
+/*******************************************************/
+
+unsigned long ADCRingRead(tADCRing *ring, tADCFrame *frames, unsigned long maxFrames){
+	unsigned long tail = ring->Tail;
+	unsigned long count = ring->Head - tail;	/* frames up to Head are complete */
+	unsigned long n;
+	volatile tADCFrame *frame;
+	int i;
+
+	if (count > maxFrames){
+		count = maxFrames;
+	}
+	for (n=0;n<count;n++){
+		frame = &ring->Frame[(tail+n) & (ADC_RING_SIZE-1)];
+		frames[n].Tick = frame->Tick;
+		for (i=0;i<ADC_RING_CHANNELS;i++){
+			frames[n].Sample[i] = frame->Sample[i];
+		}
+	}
+	ring->Tail = tail+count;		/* release the slots to the producer */
+	return count;
+}
+
+/*******************************************************/
+/*  Discard every frame written so far                 */
+/*******************************************************/
+
+void ADCRingFlush(tADCRing *ring){
+	ring->Tail = ring->Head;
+}
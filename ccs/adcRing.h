@@ -0,0 +1,71 @@
+#ifndef ADCRING_H_
+#define ADCRING_H_
+
+/*****************************************************************************************/
+/* ADC sample ring                                                                       */
+/*                                                                                       */
+/* Single producer / single consumer ring of timestamped sample frames between the ADC   */
+/* interrupt handler and the background loop.  The producer only writes Head and the    */
+/* consumer only writes Tail, and a frame is complete before Head moves past it, so      */
+/* neither side ever needs to disable interrupts.  Head and Tail run freely and are      */
+/* reduced modulo ADC_RING_SIZE (a power of two) when indexing.  A frame that finds the  */
+/* ring full is dropped and counted in Overruns; the reader keeps the older samples.     */
+/*****************************************************************************************/
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#ifndef ADC_RING_SIZE
+#define ADC_RING_SIZE 32			/* frames, must be a power of two */
+#endif
+#define ADC_RING_CHANNELS 2
+
+typedef struct {
+	unsigned long Tick;						/* SysTick tick the conversion was triggered on	*/
+	unsigned short Sample[ADC_RING_CHANNELS];	/* raw 10 bit samples of ch0, ch1			*/
+} tADCFrame;
+
+typedef struct {
+	volatile tADCFrame Frame[ADC_RING_SIZE];
+	volatile unsigned long Head;			/* frames written, producer only			*/
+	volatile unsigned long Tail;			/* frames read, consumer only				*/
+	volatile unsigned long Overruns;		/* frames dropped on a full ring, producer only	*/
+} tADCRing;
+
+/************************************/
+/*	Producer and consumer     		*/
+/************************************/
+
+/* Frames waiting to be read */
+static __inline unsigned long ADCRingCount(tADCRing *ring){
+	return ring->Head - ring->Tail;
+}
+
+/* Called from the ADC interrupt only. Returns 0, or -1 if the frame was dropped */
+static __inline int ADCRingPut(tADCRing *ring, unsigned long tick, const unsigned long *samples){
+	unsigned long head = ring->Head;
+	volatile tADCFrame *frame;
+	int i;
+
+	if ((head - ring->Tail) >= ADC_RING_SIZE){
+		ring->Overruns++;
+		return -1;
+	}
+	frame = &ring->Frame[head & (ADC_RING_SIZE-1)];
+	frame->Tick = tick;
+	for (i=0;i<ADC_RING_CHANNELS;i++){
+		frame->Sample[i] = (unsigned short)samples[i];
+	}
+	ring->Head = head+1;		/* publish the frame */
+	return 0;
+}
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern void ADCRingInit(tADCRing *ring);
+extern unsigned long ADCRingRead(tADCRing *ring, tADCFrame *frames, unsigned long maxFrames);
+extern void ADCRingFlush(tADCRing *ring);
+
+#endif /*ADCRING_H_*/
@@ -0,0 +1,31 @@
+/*****************************************************************************************/
+/* CRC-32                                                                                */
+/*                                                                                       */
+/* Nibble table implementation of the CRC in crc32.h.                                    */
+/*****************************************************************************************/
+
+#include "crc32.h"
+
+static const unsigned int Crc32Table[16] = {
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+	0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+	0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+/*******************************************************/
+/*  CRC of data[0..n-1] continued from crc, which is   */
+/*  CRC32_INIT or the result of the previous block.    */
+/*******************************************************/
+
+unsigned long Crc32(unsigned long crc, const void *data, unsigned long n){
+	const unsigned char *p = (const unsigned char *)data;
+	unsigned int c = ~(unsigned int)crc;
+
+	while (n--){
+		c ^= *p++;
+		c = (c >> 4) ^ Crc32Table[c & 0x0F];
+		c = (c >> 4) ^ Crc32Table[c & 0x0F];
+	}
+	return ~c;
+}
@@ -0,0 +1,24 @@
+#ifndef CRC32_H_
+#define CRC32_H_
+
+/*****************************************************************************************/
+/* CRC-32                                                                                */
+/*                                                                                       */
+/* The IEEE 802.3 / zlib CRC (reflected polynomial 0xEDB88320, initial value and final   */
+/* xor 0xFFFFFFFF), so a record can be checked on the host with any zip tool or          */
+/* zlib.crc32().  It is computed a nibble at a time from a 16 entry table: 64 bytes of   */
+/* flash instead of 1 KB, for two lookups per byte.                                      */
+/*****************************************************************************************/
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#define CRC32_INIT 0		/* value to start with, and to chain blocks from */
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern unsigned long Crc32(unsigned long crc, const void *data, unsigned long n);
+
+#endif /*CRC32_H_*/
@@ -8,9 +8,14 @@
 
 --retain=g_pfnVectors
 
+/* The last two 1 KB flash blocks are the weight store (weightStore.h).      */
+/* Nothing is linked there, so a download that only erases the sectors it    */
+/* needs keeps the trained weights.                                          */
+
 MEMORY
 {
-    FLASH (RX) : origin = 0x00000000, length = 0x00040000
+    FLASH (RX) : origin = 0x00000000, length = 0x0003F800
+    WSTORE (R) : origin = 0x0003F800, length = 0x00000800
     SRAM (RWX) : origin = 0x20000000, length = 0x00010000
 }
 
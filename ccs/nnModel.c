@@ -0,0 +1,231 @@
+/*****************************************************************************************/
+/* Binary network model                                                                  */
+/*                                                                                       */
+/* Checking, building and running models in place, see nnModel.h.                        */
+/*****************************************************************************************/
+
+#include <string.h>
+#include "nnModel.h"
+#include "supervisedNN.h"
+#include "supervisedNNFixed.h"
+#include "crc32.h"
+
+#define NN_MODEL_CRC_BYTES ((unsigned long)&((tNNModel *)0)->Crc)
+
+/*******************************************************/
+/*  Sizes                                              */
+/*******************************************************/
+
+unsigned long NNModelWeightCount(const unsigned short *sizes, int layerCount){
+	unsigned long words=0;
+	int l;
+
+	for (l=0;l<layerCount-1;l++){
+		words += NN_MODEL_LAYER_WORDS(sizes[l], sizes[l+1]);
+	}
+	return words;
+}
+
+/* Bytes of the whole model, header included */
+unsigned long NNModelBytes(const tNNModel *model){
+	return model->HeaderSize + model->NumWeights*4;
+}
+
+/* Activations needed by NNModelForward(), in floats (or longs for Q15) */
+unsigned long NNModelActSize(const tNNModel *model){
+	unsigned long n=0;
+	int l;
+
+	for (l=0;l<model->LayerCount;l++){
+		n += model->Size[l]+1;
+	}
+	return n;
+}
+
+/* Weights from layer to layer+1, in place */
+const void *NNModelLayer(const tNNModel *model, int layer){
+	const unsigned int *w = (const unsigned int *)((const char *)model + model->HeaderSize);
+
+	return w + NNModelWeightCount(model->Size, layer+1);
+}
+
+/*******************************************************/
+/*  Check a model of at most bytes bytes before        */
+/*  running it.  Returns 0, or -1 if it is misaligned, */
+/*  truncated, of another version or corrupted.        */
+/*******************************************************/
+
+int NNModelCheck(const tNNModel *model, unsigned long bytes){
+	unsigned long crc;
+	int l;
+
+	if (((unsigned long)model & 3) || (bytes < sizeof(tNNModel)) ||
+		(model->Magic != NN_MODEL_MAGIC) || (model->Version != NN_MODEL_VERSION) ||
+		(model->HeaderSize < sizeof(tNNModel)) || (model->HeaderSize & 3) ||
+		(model->Type > NN_MODEL_Q15) || (model->LayerCount < 2) ||
+		(model->LayerCount > NN_MODEL_MAX_LAYERS)){
+		return -1;
+	}
+	for (l=0;l<model->LayerCount;l++){
+		if (model->Size[l]==0){
+			return -1;
+		}
+	}
+	if ((model->NumWeights != NNModelWeightCount(model->Size, model->LayerCount)) ||
+		(NNModelBytes(model) > bytes)){
+		return -1;
+	}
+	crc = Crc32(CRC32_INIT, model, NN_MODEL_CRC_BYTES);
+	crc = Crc32(crc, NNModelLayer(model, 0), model->NumWeights*4);
+	return ((unsigned int)crc == model->Crc) ? 0 : -1;
+}
+
+/*******************************************************/
+/*  Build a model in a buffer of bytes bytes, 4 byte   */
+/*  aligned: header and zero weights.  Fill the layers */
+/*  with NNModelSetLayer(), then NNModelSeal().        */
+/*  Returns the size of the model, or 0 if it does not */
+/*  fit or the topology is not valid.                  */
+/*******************************************************/
+
+unsigned long NNModelInit(tNNModel *model, unsigned long bytes, const unsigned short *sizes, int layerCount, int type, float bias){
+	unsigned long size;
+	int l;
+
+	if ((layerCount < 2) || (layerCount > NN_MODEL_MAX_LAYERS)){
+		return 0;
+	}
+	size = sizeof(tNNModel) + NNModelWeightCount(sizes, layerCount)*4;
+	if (size > bytes){
+		return 0;
+	}
+	memset(model, 0, size);
+	model->Magic = NN_MODEL_MAGIC;
+	model->Version = NN_MODEL_VERSION;
+	model->HeaderSize = sizeof(tNNModel);
+	model->Type = (unsigned char)type;
+	model->LayerCount = (unsigned char)layerCount;
+	model->HidAct = NN_MODEL_SIGMOID;
+	model->OutAct = NN_MODEL_SIGMOID;
+	for (l=0;l<layerCount;l++){
+		model->Size[l] = sizes[l];
+	}
+	model->Bias = bias;
+	model->NumWeights = NNModelWeightCount(sizes, layerCount);
+	return size;
+}
+
+/*******************************************************/
+/*  Copy the float weights from layer to layer+1,      */
+/*  converted to the model type.  The weight from      */
+/*  input i (0 is the bias) to output j (from 0) is    */
+/*  weights[i*inStride+j*outStride], as in             */
+/*  WeightsInit().                                     */
+/*******************************************************/
+
+void NNModelSetLayer(tNNModel *model, int layer, const float *weights, int inStride, int outStride){
+	int nIn = model->Size[layer];
+	int nOut = model->Size[layer+1];
+	unsigned int *dst = (unsigned int *)NNModelLayer(model, layer);
+	float *f = (float *)dst;
+	int *q = (int *)dst;
+	int i,j;
+
+	for (j=0;j<nOut;j++){
+		for (i=0;i<=nIn;i++){
+			if (model->Type == NN_MODEL_Q15){
+				*q++ = (int)FloatToQ15(weights[i*inStride+j*outStride]);
+			}
+			else {
+				*f++ = weights[i*inStride+j*outStride];
+			}
+		}
+	}
+}
+
+void NNModelSeal(tNNModel *model){
+	unsigned long crc;
+
+	crc = Crc32(CRC32_INIT, model, NN_MODEL_CRC_BYTES);
+	crc = Crc32(crc, NNModelLayer(model, 0), model->NumWeights*4);
+	model->Crc = (unsigned int)crc;
+}
+
+/*******************************************************/
+/***********  Forward Algorithm                        */
+/*  Runs a checked NN_MODEL_FLOAT model in place.      */
+/*  act holds NNModelActSize() floats.  Returns the    */
+/*  Size[LayerCount-1] outputs, inside act.            */
+/*******************************************************/
+
+const float *NNModelForward(const tNNModel *model, const float *inputs, float *act){
+	const float *w = (const float *)NNModelLayer(model, 0);
+	float *in = act;
+	float *out;
+	float sum;
+	int i,j,l;
+	int nIn, nOut;
+
+	in[0] = model->Bias;
+	for (i=0;i<model->Size[0];i++){
+		in[i+1] = inputs[i];
+	}
+	for (l=0;l<model->LayerCount-1;l++){
+		nIn = model->Size[l]+1;
+		nOut = model->Size[l+1];
+		out = in+nIn;
+		out[0] = model->Bias;
+		for (j=1;j<=nOut;j++){
+			sum=0;
+			for (i=0;i<nIn;i++){
+				sum += in[i]*w[i];
+			}
+			if (((l==model->LayerCount-2) ? model->OutAct : model->HidAct) == NN_MODEL_SIGMOID){
+				sum = NN_SIGMOID(sum);
+			}
+			out[j] = sum;
+			w += nIn;
+		}
+		in = out;
+	}
+	return in+1;
+}
+
+/*******************************************************/
+/*  Same for a NN_MODEL_Q15 model, with Q15 inputs,    */
+/*  activations and outputs.                           */
+/*******************************************************/
+
+const long *NNModelForwardQ15(const tNNModel *model, const long *inputs, long *act){
+	const int *w = (const int *)NNModelLayer(model, 0);
+	long bias = FloatToQ15(model->Bias);
+	long *in = act;
+	long *out;
+	long long sum;
+	int i,j,l;
+	int nIn, nOut;
+
+	in[0] = bias;
+	for (i=0;i<model->Size[0];i++){
+		in[i+1] = inputs[i];
+	}
+	for (l=0;l<model->LayerCount-1;l++){
+		nIn = model->Size[l]+1;
+		nOut = model->Size[l+1];
+		out = in+nIn;
+		out[0] = bias;
+		for (j=1;j<=nOut;j++){
+			sum=0;
+			for (i=0;i<nIn;i++){
+				sum += (long long)in[i]*w[i];
+			}
+			out[j] = Q15Sat((sum+(1<<14))>>15);
+			if (((l==model->LayerCount-2) ? model->OutAct : model->HidAct) == NN_MODEL_SIGMOID){
+				out[j] = sigmoidQ15(out[j]);
+			}
+			w += nIn;
+		}
+		in = out;
+	}
+	return in+1;
+}
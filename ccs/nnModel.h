@@ -0,0 +1,68 @@
+#ifndef NNMODEL_H_
+#define NNMODEL_H_
+
+/*****************************************************************************************/
+/* Binary network model                                                                  */
+/*                                                                                       */
+/* A model is a tNNModel header followed by the weights of every layer, back to back,    */
+/* in the order of the layer stack (supervisedNNStack.h): for layer l, the weights of    */
+/* neuron j+1 of layer l+1 are Size[l]+1 words starting with the bias weight.  Every     */
+/* field is 32 bits or less and the weights are 32 bit words at a 4 byte aligned offset, */
+/* so a model placed at an aligned address runs where it is: a const array or a block   */
+/* of the flash on the target, a mmap()ed file on the host, with only the activations    */
+/* in RAM.  The bytes are little-endian, as on the Cortex-M3 and the x86 host.           */
+/*                                                                                       */
+/* The weights are IEEE 754 floats (NN_MODEL_FLOAT) or Q15 numbers in 32 bit words       */
+/* (NN_MODEL_Q15).  The CRC-32 (crc32.h) covers the header up to Crc and the weights.    */
+/* host/nnmodel converts models to and from text, C arrays and the flash weight store.  */
+/*****************************************************************************************/
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#define NN_MODEL_MAGIC 0x4C444D4E		/* "NMDL" */
+#define NN_MODEL_VERSION 1				/* layout of tNNModel */
+#define NN_MODEL_MAX_LAYERS 8
+
+/* Type of the weights */
+#define NN_MODEL_FLOAT 0
+#define NN_MODEL_Q15 1
+
+/* Activation of a layer */
+#define NN_MODEL_SIGMOID 0				/* NN_SIGMOID in float, sigmoidQ15() in Q15 */
+#define NN_MODEL_LINEAR 1
+
+/* Words of weights from a layer of from neurons to one of to neurons */
+#define NN_MODEL_LAYER_WORDS(from, to) (((from)+1)*(to))
+
+typedef struct {
+	unsigned int Magic;						/* NN_MODEL_MAGIC							*/
+	unsigned short Version;					/* NN_MODEL_VERSION							*/
+	unsigned short HeaderSize;				/* bytes before the weights					*/
+	unsigned char Type;						/* NN_MODEL_FLOAT or NN_MODEL_Q15			*/
+	unsigned char LayerCount;				/* input + hidden + output layers			*/
+	unsigned char HidAct;					/* activation of the hidden layers			*/
+	unsigned char OutAct;					/* activation of the output layer			*/
+	unsigned short Size[NN_MODEL_MAX_LAYERS];	/* neurons per layer, bias not included	*/
+	float Bias;								/* value of the bias inputs					*/
+	unsigned int NumWeights;				/* 32 bit words after the header			*/
+	unsigned int Crc;						/* CRC-32 of the header up to here and of	*/
+											/* the weights								*/
+} tNNModel;
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern unsigned long NNModelWeightCount(const unsigned short *sizes, int layerCount);
+extern unsigned long NNModelBytes(const tNNModel *model);
+extern unsigned long NNModelActSize(const tNNModel *model);
+extern const void *NNModelLayer(const tNNModel *model, int layer);
+extern int NNModelCheck(const tNNModel *model, unsigned long bytes);
+extern unsigned long NNModelInit(tNNModel *model, unsigned long bytes, const unsigned short *sizes, int layerCount, int type, float bias);
+extern void NNModelSetLayer(tNNModel *model, int layer, const float *weights, int inStride, int outStride);
+extern void NNModelSeal(tNNModel *model);
+extern const float *NNModelForward(const tNNModel *model, const float *inputs, float *act);
+extern const long *NNModelForwardQ15(const tNNModel *model, const long *inputs, long *act);
+
+#endif /*NNMODEL_H_*/
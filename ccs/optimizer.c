@@ -0,0 +1,287 @@
+/*****************************************************************************************/
+/* Weight update rules                                                                   */
+/*                                                                                       */
+/* Arena, state and float / Q15 updates of the optimizers in optimizer.h.                */
+/*****************************************************************************************/
+
+#include <math.h>
+#include <string.h>
+#include "optimizer.h"
+#include "supervisedNNFixed.h"
+
+#define OPT_ALIGN 8				/* long long state on the target */
+#define OPT_GRAD_MAX (256*Q15_ONE)	/* keeps g*g*(1-b2) in 64 bits */
+
+/*******************************************************/
+/*  Arena: bump allocator over a caller's buffer, the  */
+/*  state lives as long as the buffer.                 */
+/*******************************************************/
+
+void OptArenaInit(tOptArena *arena, void *base, unsigned long size){
+	arena->Base = (unsigned char *)base;
+	arena->Size = size;
+	arena->Used = 0;
+}
+
+/* size zeroed bytes, 8 byte aligned, or 0 if the arena is full */
+void *OptArenaAlloc(tOptArena *arena, unsigned long size){
+	unsigned long start = (arena->Used + OPT_ALIGN-1) & ~(unsigned long)(OPT_ALIGN-1);
+	void *block;
+
+	if ((start > arena->Size) || (size > arena->Size-start)){
+		return 0;
+	}
+	block = arena->Base + start;
+	arena->Used = start + size;
+	memset(block, 0, size);
+	return block;
+}
+
+/*******************************************************/
+/*  Set up an optimizer with the default parameters of */
+/*  method.  The weight arrays follow with             */
+/*  OptimizerAdd().                                    */
+/*******************************************************/
+
+void OptimizerInit(tOptimizer *opt, int method, float eta, int fixed){
+	memset(opt, 0, sizeof(*opt));
+	opt->Method = (unsigned char)method;
+	opt->Fixed = (unsigned char)fixed;
+	opt->Eta = eta;
+	opt->Beta1 = OPT_BETA1;
+	opt->Beta2 = (method == OPT_ADAM) ? OPT_BETA2_ADAM : OPT_BETA2_RMSPROP;
+	opt->Epsilon = OPT_EPSILON;
+	OptimizerReset(opt);
+}
+
+/*******************************************************/
+/*  Add an array of count weights, its state is taken  */
+/*  from arena.  Returns the parameter index given to  */
+/*  OptimizerApply(), or -1 if the arena is full.      */
+/*******************************************************/
+
+int OptimizerAdd(tOptimizer *opt, tOptArena *arena, unsigned long count){
+	int param = opt->NumParams;
+	unsigned long mSize = opt->Fixed ? sizeof(long) : sizeof(float);
+	unsigned long sSize = opt->Fixed ? sizeof(long long) : sizeof(float);
+
+	if (param >= OPT_MAX_PARAMS){
+		return -1;
+	}
+	opt->M[param] = 0;
+	opt->S[param] = 0;
+	if (opt->Method != OPT_SGD && opt->Method != OPT_RMSPROP){
+		if ((opt->M[param] = OptArenaAlloc(arena, count*mSize)) == 0){
+			return -1;
+		}
+	}
+	if (opt->Method >= OPT_RMSPROP){
+		if ((opt->S[param] = OptArenaAlloc(arena, count*sSize)) == 0){
+			return -1;
+		}
+	}
+	opt->Count[param] = count;
+	opt->NumParams++;
+	return param;
+}
+
+/*******************************************************/
+/*  Clear the state, before a new training, and take   */
+/*  the parameters into account.                       */
+/*******************************************************/
+
+void OptimizerReset(tOptimizer *opt){
+	int p;
+
+	for (p=0;p<opt->NumParams;p++){
+		if (opt->M[p]){
+			memset(opt->M[p], 0, opt->Count[p]*(opt->Fixed ? sizeof(long) : sizeof(float)));
+		}
+		if (opt->S[p]){
+			memset(opt->S[p], 0, opt->Count[p]*(opt->Fixed ? sizeof(long long) : sizeof(float)));
+		}
+	}
+	opt->Steps = 0;
+	opt->Step = opt->Eta;
+	opt->Beta1Pow = 1;
+	opt->Beta2Pow = 1;
+	if (opt->Fixed){
+		opt->EtaQ = FloatToQ15(opt->Eta);
+		opt->Beta1Q = FloatToQ15(opt->Beta1);
+		opt->Beta2Q = FloatToQ15(opt->Beta2);
+		opt->EpsilonQ = FloatToQ15(opt->Epsilon);
+		if (opt->EpsilonQ < 1){
+			opt->EpsilonQ = 1;
+		}
+		opt->StepQ = opt->EtaQ;
+		opt->Beta1PowQ = Q15_ONE;
+		opt->Beta2PowQ = Q15_ONE;
+	}
+}
+
+/* New eta that keeps the state, from a schedule (schedule.h) */
+void OptimizerSetEta(tOptimizer *opt, float eta){
+	opt->Eta = eta;
+	if (opt->Fixed){
+		opt->EtaQ = FloatToQ15(eta);
+	}
+}
+
+/* floor(sqrt(x)), one result bit per iteration */
+static unsigned long OptSqrt(unsigned long long x){
+	unsigned long long root = 0;
+	unsigned long long bit = 1ULL << 62;
+
+	while (bit > x){
+		bit >>= 2;
+	}
+	while (bit){
+		if (x >= root + bit){
+			x -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+	return (unsigned long)root;
+}
+
+/*******************************************************/
+/*  Start an update: call once before the              */
+/*  OptimizerApply() of its weight arrays.             */
+/*******************************************************/
+
+void OptimizerBegin(tOptimizer *opt){
+	opt->Steps++;
+	if (opt->Method != OPT_ADAM){
+		return;
+	}
+	if (opt->Fixed){
+		opt->Beta1PowQ = Q15Mul(opt->Beta1PowQ, opt->Beta1Q);
+		opt->Beta2PowQ = Q15Mul(opt->Beta2PowQ, opt->Beta2Q);
+		opt->StepQ = Q15Sat((long long)opt->EtaQ * OptSqrt((unsigned long long)(Q15_ONE-opt->Beta2PowQ) << 15) /
+							(Q15_ONE-opt->Beta1PowQ));
+	}
+	else {
+		opt->Beta1Pow *= opt->Beta1;
+		opt->Beta2Pow *= opt->Beta2;
+		opt->Step = opt->Eta*sqrtf(1-opt->Beta2Pow)/(1-opt->Beta1Pow);
+	}
+}
+
+/*******************************************************/
+/*  Update the weights of parameter param from their   */
+/*  gradient sums, and clear the sums.                 */
+/*******************************************************/
+
+void OptimizerApply(tOptimizer *opt, int param, float *weights, float *grad){
+	float *m = (float *)opt->M[param];
+	float *s = (float *)opt->S[param];
+	unsigned long n = opt->Count[param];
+	float eta = opt->Eta;
+	float b1 = opt->Beta1;
+	float b2 = opt->Beta2;
+	float g;
+
+	switch (opt->Method){
+	case OPT_MOMENTUM:
+		while (n--){
+			*m = b1*(*m) + eta*(*grad);
+			*weights++ += *m++;
+			*grad++ = 0;
+		}
+		break;
+	case OPT_NESTEROV:
+		while (n--){
+			g = eta*(*grad);
+			*m = b1*(*m) + g;
+			*weights++ += b1*(*m++) + g;
+			*grad++ = 0;
+		}
+		break;
+	case OPT_RMSPROP:
+		while (n--){
+			g = *grad;
+			*s = b2*(*s) + (1-b2)*g*g;
+			*weights++ += eta*g/(sqrtf(*s++)+opt->Epsilon);
+			*grad++ = 0;
+		}
+		break;
+	case OPT_ADAM:
+		eta = opt->Step;
+		while (n--){
+			g = *grad;
+			*m = b1*(*m) + (1-b1)*g;
+			*s = b2*(*s) + (1-b2)*g*g;
+			*weights++ += eta*(*m++)/(sqrtf(*s++)+opt->Epsilon);
+			*grad++ = 0;
+		}
+		break;
+	default:
+		while (n--){
+			*weights++ += eta*(*grad);
+			*grad++ = 0;
+		}
+		break;
+	}
+}
+
+/* Same in Q15, s in Q30 */
+void OptimizerApplyQ15(tOptimizer *opt, int param, long *weights, long *grad){
+	long *m = (long *)opt->M[param];
+	long long *s = (long long *)opt->S[param];
+	unsigned long n = opt->Count[param];
+	long eta = opt->EtaQ;
+	long b1 = opt->Beta1Q;
+	long b2 = opt->Beta2Q;
+	long g;
+
+	switch (opt->Method){
+	case OPT_MOMENTUM:
+		while (n--){
+			*m = Q15Add(Q15Mul(b1, *m), Q15Mul(eta, *grad));
+			*weights = Q15Add(*weights, *m++);
+			weights++;
+			*grad++ = 0;
+		}
+		break;
+	case OPT_NESTEROV:
+		while (n--){
+			g = Q15Mul(eta, *grad);
+			*m = Q15Add(Q15Mul(b1, *m), g);
+			*weights = Q15Add(*weights, Q15Add(Q15Mul(b1, *m++), g));
+			weights++;
+			*grad++ = 0;
+		}
+		break;
+	case OPT_RMSPROP:
+	case OPT_ADAM:
+		if (opt->Method == OPT_ADAM){
+			eta = opt->StepQ;
+		}
+		while (n--){
+			g = *grad;
+			if (g > OPT_GRAD_MAX) g = OPT_GRAD_MAX;
+			if (g < -OPT_GRAD_MAX) g = -OPT_GRAD_MAX;
+			*s += (((long long)g*g - *s) * (Q15_ONE-b2)) >> 15;
+			if (opt->Method == OPT_ADAM){
+				*m = Q15Add(*m, Q15Mul(g - *m, Q15_ONE-b1));
+				g = *m++;
+			}
+			*weights = Q15Add(*weights, Q15Sat(((long long)Q15Mul(eta, g) << 15) /
+										(long long)(OptSqrt(*s++) + opt->EpsilonQ)));
+			weights++;
+			*grad++ = 0;
+		}
+		break;
+	default:
+		while (n--){
+			*weights = Q15Add(*weights, Q15Mul(eta, *grad));
+			weights++;
+			*grad++ = 0;
+		}
+		break;
+	}
+}
@@ -0,0 +1,83 @@
+#ifndef OPTIMIZER_H_
+#define OPTIMIZER_H_
+
+/*****************************************************************************************/
+/* Weight update rules                                                                   */
+/*                                                                                       */
+/* An optimizer turns the gradient sums of AccumulateGradients() into weight updates.    */
+/* g is the sum of delta*activation, the descent direction, as in ApplyGradients():      */
+/*                                                                                       */
+/*   OPT_SGD       w += eta*g                                                            */
+/*   OPT_MOMENTUM  v = b1*v + eta*g, w += v                                              */
+/*   OPT_NESTEROV  v = b1*v + eta*g, w += b1*v + eta*g                                   */
+/*   OPT_RMSPROP   s = b2*s + (1-b2)*g*g, w += eta*g/(sqrt(s)+eps)                       */
+/*   OPT_ADAM      m = b1*m + (1-b1)*g, s as RMSProp, w += eta_t*m/(sqrt(s)+eps)         */
+/*                                                                                       */
+/* OPT_ADAM is a light Adam: the bias correction is folded into one step size,           */
+/* eta_t = eta*sqrt(1-b2^t)/(1-b1^t), computed once per update and not per weight.       */
+/* The per-weight state (v, m, s) is carved out of a tOptArena, a buffer the caller      */
+/* allocates statically, so there is no heap and the size is known at link time.         */
+/*                                                                                       */
+/* The Q15 variants work on the long weights and gradients of supervisedNNFixed.h with   */
+/* no floating point: v and m are Q15, s is Q30 in 64 bits (a Q15 square of a small      */
+/* gradient would round to zero) and the square root is an integer one.                  */
+/*****************************************************************************************/
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#define OPT_SGD 0
+#define OPT_MOMENTUM 1
+#define OPT_NESTEROV 2
+#define OPT_RMSPROP 3
+#define OPT_ADAM 4
+#define OPT_METHODS 5
+
+#define OPT_MAX_PARAMS 4		/* weight arrays per optimizer */
+
+/* Defaults set by OptimizerInit() */
+#define OPT_BETA1 0.9f			/* momentum, first moment decay  */
+#define OPT_BETA2_RMSPROP 0.9f	/* second moment decay           */
+#define OPT_BETA2_ADAM 0.999f
+#define OPT_EPSILON 1e-4f		/* about 3 in Q15                */
+
+/* Arena bytes enough for any method and numeric type: count weights in */
+/* params arrays, alignment included                                    */
+#define OPT_ARENA_BYTES(count, params) ((count)*(sizeof(long)+sizeof(long long)) + (params)*16)
+
+typedef struct {
+	unsigned char *Base;
+	unsigned long Size;
+	unsigned long Used;
+} tOptArena;
+
+typedef struct {
+	unsigned char Method;				/* OPT_SGD ... OPT_ADAM						*/
+	unsigned char Fixed;				/* Q15 state and updates					*/
+	unsigned char NumParams;
+	unsigned long Steps;				/* updates since OptimizerReset()			*/
+	float Eta, Beta1, Beta2, Epsilon;	/* set by OptimizerInit(), change them and	*/
+										/* call OptimizerReset()					*/
+	float Step;							/* eta of the current update				*/
+	float Beta1Pow, Beta2Pow;			/* b1^t and b2^t							*/
+	long EtaQ, Beta1Q, Beta2Q, EpsilonQ, StepQ, Beta1PowQ, Beta2PowQ;
+	unsigned long Count[OPT_MAX_PARAMS];	/* weights per array					*/
+	void *M[OPT_MAX_PARAMS];			/* v or m, float or Q15						*/
+	void *S[OPT_MAX_PARAMS];			/* s, float or Q30							*/
+} tOptimizer;
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern void OptArenaInit(tOptArena *arena, void *base, unsigned long size);
+extern void *OptArenaAlloc(tOptArena *arena, unsigned long size);
+extern void OptimizerInit(tOptimizer *opt, int method, float eta, int fixed);
+extern int OptimizerAdd(tOptimizer *opt, tOptArena *arena, unsigned long count);
+extern void OptimizerReset(tOptimizer *opt);
+extern void OptimizerSetEta(tOptimizer *opt, float eta);
+extern void OptimizerBegin(tOptimizer *opt);
+extern void OptimizerApply(tOptimizer *opt, int param, float *weights, float *grad);
+extern void OptimizerApplyQ15(tOptimizer *opt, int param, long *weights, long *grad);
+
+#endif /*OPTIMIZER_H_*/
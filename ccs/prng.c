@@ -0,0 +1,85 @@
+/*****************************************************************************************/
+/* Pseudo random number generator                                                        */
+/*                                                                                       */
+/* Seeding and bulk fill of the xoshiro128+ generator in prng.h.                         */
+/*****************************************************************************************/
+
+#include "prng.h"
+
+/*******************************************************/
+/*  Expand a 32 bit seed into the 128 bit state.       */
+/*  PRNGHash() is a bijection and the four inputs are  */
+/*  distinct, so at most one word is zero.  Every seed */
+/*  gives a different sequence, 0 included.           */
+/*******************************************************/
+
+void PRNGSeed(tPRNG *rng, unsigned long seed){
+	unsigned int x = (unsigned int)seed;
+	int i;
+
+	for (i=0;i<4;i++){
+		x += 0x9E3779B9U;			/* golden ratio increment, as in splitmix */
+		rng->State[i] = PRNGHash(x);
+	}
+}
+
+/*******************************************************/
+/*  Fill dst[0..n-1] with floats uniform in [min,max). */
+/*  Same values as n calls of PRNGFloat(), but the     */
+/*  state stays in registers for the whole loop and    */
+/*  the scale and offset are computed once.            */
+/*******************************************************/
+
+void PRNGFill(tPRNG *rng, float *dst, unsigned long n, float min, float max){
+	unsigned int s0 = rng->State[0];
+	unsigned int s1 = rng->State[1];
+	unsigned int s2 = rng->State[2];
+	unsigned int s3 = rng->State[3];
+	unsigned int t;
+	float scale = max-min;
+	float offset = min-scale;
+	tPRNGFloat u;
+
+	while (n--){
+		u.Bits = PRNG_FLOAT_ONE | ((s0 + s3) >> 9);
+		t = s1 << 9;
+		s2 ^= s0;
+		s3 ^= s1;
+		s1 ^= s2;
+		s0 ^= s3;
+		s2 ^= t;
+		s3 = PRNGRotl(s3, 11);
+		*dst++ = u.Value*scale + offset;
+	}
+	rng->State[0] = s0;
+	rng->State[1] = s1;
+	rng->State[2] = s2;
+	rng->State[3] = s3;
+}
+
+/*******************************************************/
+/*  Random permutation of 0..n-1 in index[], written   */
+/*  in place with the inside-out Fisher-Yates shuffle: */
+/*  one PRNGRange() per entry, no scratch array, and   */
+/*  the previous content of index[] does not matter.   */
+/*******************************************************/
+
+void PRNGPermutation(tPRNG *rng, unsigned short *index, unsigned long n){
+	unsigned long i, j;
+
+	for (i=0;i<n;i++){
+		j = PRNGRange(rng, i+1);
+		index[i] = index[j];
+		index[j] = (unsigned short)i;
+	}
+}
+
+/*******************************************************/
+/*  count indexes drawn from 0..n-1 with replacement   */
+/*******************************************************/
+
+void PRNGSample(tPRNG *rng, unsigned short *index, unsigned long count, unsigned long n){
+	while (count--){
+		*index++ = (unsigned short)PRNGRange(rng, n);
+	}
+}
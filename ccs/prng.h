@@ -0,0 +1,110 @@
+#ifndef PRNG_H_
+#define PRNG_H_
+
+/*****************************************************************************************/
+/* Pseudo random number generator                                                        */
+/*                                                                                       */
+/* xoshiro128+ (Blackman and Vigna): 128 bits of state, period 2^128-1, and only 32 bit  */
+/* adds, xors, shifts and rotates, about a dozen cycles on the Cortex-M3.  The state is  */
+/* an explicit tPRNG, so a sequence only depends on its seed and on the calls made on    */
+/* that state, whatever the C runtime does with rand().  The low bits of xoshiro128+ are */
+/* its weakest, so floats and ranges are always taken from the high bits.                */
+/*                                                                                       */
+/* Floats are built by putting 23 random bits in the mantissa of a number in [1,2), so   */
+/* there is no int to float conversion and no divide, only one multiply and one add to   */
+/* map it on [min,max).  The words are unsigned int, which is 32 bits on the target and  */
+/* on the host alike.                                                                    */
+/*****************************************************************************************/
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#define PRNG_FLOAT_ONE 0x3F800000	/* 1.0f, exponent of [1,2) */
+
+typedef struct {
+	unsigned int State[4];			/* never all zero, set by PRNGSeed()		*/
+} tPRNG;
+
+typedef union {
+	unsigned int Bits;
+	float Value;
+} tPRNGFloat;
+
+/************************************/
+/*	Generator       				*/
+/************************************/
+
+static __inline unsigned int PRNGRotl(unsigned int x, int k){
+	return (x << k) | (x >> (32-k));
+}
+
+/* 32 random bits */
+static __inline unsigned int PRNGNext(tPRNG *rng){
+	unsigned int *s = rng->State;
+	unsigned int result = s[0] + s[3];
+	unsigned int t = s[1] << 9;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = PRNGRotl(s[3], 11);
+	return result;
+}
+
+/* Uniform in [min,max), 23 bit resolution */
+static __inline float PRNGFloat(tPRNG *rng, float min, float max){
+	tPRNGFloat u;
+	float scale = max-min;
+
+	u.Bits = PRNG_FLOAT_ONE | (PRNGNext(rng) >> 9);	/* [1,2) */
+	return u.Value*scale + (min-scale);
+}
+
+/* Approximately normal, mean 0 and standard deviation 1: the sum of four      */
+/* uniforms (Irwin-Hall), no log, sqrt or cos.  Bounded to +-2*sqrt(3)         */
+static __inline float PRNGNormal(tPRNG *rng){
+	tPRNGFloat u;
+	float sum = -6.0f;
+	int i;
+
+	for (i=0;i<4;i++){
+		u.Bits = PRNG_FLOAT_ONE | (PRNGNext(rng) >> 9);	/* [1,2) */
+		sum += u.Value;
+	}
+	return sum*1.7320508f;		/* variance 4/12 to 1 */
+}
+
+/* Uniform in [0,n) by a 32x32->64 multiply (one UMULL), no divide.  The bias is */
+/* at most n/2^32, below 2^-16 for n up to 65536                                 */
+static __inline unsigned long PRNGRange(tPRNG *rng, unsigned long n){
+	return (unsigned long)(((unsigned long long)PRNGNext(rng) * (unsigned int)n) >> 32);
+}
+
+/* Integer hash (Wellons' lowbias32), a bijection on 32 bits */
+static __inline unsigned int PRNGHash(unsigned int x){
+	x ^= x >> 16;
+	x *= 0x7FEB352DU;
+	x ^= x >> 15;
+	x *= 0x846CA68BU;
+	x ^= x >> 16;
+	return x;
+}
+
+/* Fold value into a running hash, to build a seed out of noisy samples.  The */
+/* increment keeps a run of zero samples off PRNGHash(0) = 0                   */
+static __inline unsigned long PRNGMix(unsigned long hash, unsigned long value){
+	return PRNGHash(((unsigned int)hash ^ (unsigned int)value) + 0x9E3779B9U);
+}
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern void PRNGSeed(tPRNG *rng, unsigned long seed);
+extern void PRNGFill(tPRNG *rng, float *dst, unsigned long n, float min, float max);
+extern void PRNGPermutation(tPRNG *rng, unsigned short *index, unsigned long n);
+extern void PRNGSample(tPRNG *rng, unsigned short *index, unsigned long count, unsigned long n);
+
+#endif /*PRNG_H_*/
@@ -0,0 +1,87 @@
+/*****************************************************************************************/
+/* Profiling scopes                                                                      */
+/*                                                                                       */
+/* Clock setup and scope bookkeeping for profile.h.  Empty unless PROFILE is defined.   */
+/*****************************************************************************************/
+
+#include "profile.h"
+
+#ifdef PROFILE
+
+#ifdef PROFILE_HOST
+#include <time.h>
+#else
+#define PROFILE_DEMCR 0xE000EDFC			/* debug exception and monitor control	*/
+#define PROFILE_DEMCR_TRCENA 0x01000000		/* enables the DWT						*/
+#define PROFILE_DWT_CTRL 0xE0001000
+#define PROFILE_DWT_CTRL_CYCCNTENA 0x00000001
+#endif
+
+#define PROFILE_CALIBRATION 16		/* empty scopes timed by ProfileInit() */
+
+tProfileScope ProfileScopes[PROFILE_MAX_SCOPES];
+unsigned long ProfileOverhead = 0;
+
+/*******************************************************/
+/*  Host clock: monotonic, in ns                       */
+/*******************************************************/
+
+#ifdef PROFILE_HOST
+unsigned long ProfileClock(void){
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long)ts.tv_sec*1000000000UL + ts.tv_nsec;
+}
+#endif
+
+/*******************************************************/
+/*  Start the clock, name the scopes and measure the   */
+/*  cost of an empty scope                             */
+/*******************************************************/
+
+void ProfileInit(const char * const *names, int count){
+	unsigned long t, best = 0;
+	int i;
+
+#ifndef PROFILE_HOST
+	HWREG(PROFILE_DEMCR) |= PROFILE_DEMCR_TRCENA;
+	HWREG(PROFILE_DWT_CTRL) |= PROFILE_DWT_CTRL_CYCCNTENA;
+#endif
+
+	for (i=0;i<PROFILE_MAX_SCOPES;i++){
+		ProfileScopes[i].Name = (i<count) ? names[i] : 0;
+		ProfileClear(i);
+	}
+
+	ProfileOverhead = 0;
+	for (i=0;i<PROFILE_CALIBRATION;i++){
+		t = ProfileClock();
+		t = ProfileClock() - t;
+		if ((i == 0) || (t < best)) best = t;
+	}
+	ProfileOverhead = best;
+}
+
+/*******************************************************/
+/*  Forget the samples of one scope                    */
+/*******************************************************/
+
+void ProfileClear(int id){
+	ProfileScopes[id].Count = 0;
+	ProfileScopes[id].Min = 0;
+	ProfileScopes[id].Max = 0;
+	ProfileScopes[id].Total = 0;
+}
+
+/*******************************************************/
+/*  Mean of the samples, 0 without samples             */
+/*******************************************************/
+
+unsigned long ProfileMean(int id){
+	tProfileScope *scope = &ProfileScopes[id];
+
+	return scope->Count ? (unsigned long)(scope->Total/scope->Count) : 0;
+}
+
+#endif /*PROFILE*/
@@ -0,0 +1,95 @@
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+/*****************************************************************************************/
+/* Profiling scopes                                                                      */
+/*                                                                                       */
+/* PROFILE_BEGIN(id) and PROFILE_END(id) around a piece of code add one sample to scope  */
+/* id: count, min, max and total, so the mean is Total/Count.  On the target the clock  */
+/* is the Cortex-M3 DWT cycle counter (DWT_CYCCNT, one tick per CPU cycle); the host    */
+/* build defines PROFILE_HOST and uses the monotonic clock in ns.  The cost of reading  */
+/* the clock twice is measured by ProfileInit() and subtracted from every sample.       */
+/* Interrupts that hit a scope are counted in it, so Min is the best estimate of the    */
+/* code itself and Max includes the interrupt latency.  Scopes do not nest with        */
+/* themselves (recursion), but different scopes nest freely.                           */
+/*                                                                                       */
+/* Everything compiles out unless PROFILE is defined (Debug configuration and host      */
+/* build), the macros then expand to nothing.                                           */
+/*****************************************************************************************/
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#define PROFILE_MAX_SCOPES 8
+
+#ifdef PROFILE_HOST
+#define PROFILE_UNIT "ns"
+#else
+#define PROFILE_UNIT "cyc"
+#define PROFILE_DWT_CYCCNT 0xE0001004	/* DWT cycle count register */
+#endif
+
+typedef struct {
+	const char *Name;				/* null for an unused scope							*/
+	unsigned long Start;			/* clock at the last PROFILE_BEGIN()				*/
+	unsigned long Count;
+	unsigned long Min;
+	unsigned long Max;
+	unsigned long long Total;
+} tProfileScope;
+
+#ifdef PROFILE
+
+#ifndef PROFILE_HOST
+#include "inc/hw_types.h"
+#endif
+
+extern tProfileScope ProfileScopes[PROFILE_MAX_SCOPES];
+extern unsigned long ProfileOverhead;
+
+/************************************/
+/*	Clock and scopes   				*/
+/************************************/
+
+#ifdef PROFILE_HOST
+extern unsigned long ProfileClock(void);
+#else
+static __inline unsigned long ProfileClock(void){
+	return HWREG(PROFILE_DWT_CYCCNT);
+}
+#endif
+
+static __inline void ProfileBegin(int id){
+	ProfileScopes[id].Start = ProfileClock();
+}
+
+static __inline void ProfileEnd(int id){
+	unsigned long t = ProfileClock() - ProfileScopes[id].Start;	/* wraps correctly */
+	tProfileScope *scope = &ProfileScopes[id];
+
+	t = (t > ProfileOverhead) ? t - ProfileOverhead : 0;
+	if ((scope->Count == 0) || (t < scope->Min)) scope->Min = t;
+	if (t > scope->Max) scope->Max = t;
+	scope->Total += t;
+	scope->Count++;
+}
+
+#define PROFILE_BEGIN(id) ProfileBegin(id)
+#define PROFILE_END(id) ProfileEnd(id)
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern void ProfileInit(const char * const *names, int count);
+extern void ProfileClear(int id);
+extern unsigned long ProfileMean(int id);
+
+#else
+
+#define PROFILE_BEGIN(id)
+#define PROFILE_END(id)
+
+#endif /*PROFILE*/
+
+#endif /*PROFILE_H_*/
@@ -0,0 +1,75 @@
+/*****************************************************************************************/
+/* Learning rate schedules                                                               */
+/*                                                                                       */
+/* Per epoch eta updates of the schedules in schedule.h.                                 */
+/*****************************************************************************************/
+
+#include "schedule.h"
+
+/* Defaults */
+#define SCHED_STEP_PERIOD 500
+#define SCHED_STEP_FACTOR 0.5f
+#define SCHED_EXP_FACTOR 0.998f
+#define SCHED_BOLD_UP 1.1f
+#define SCHED_BOLD_DOWN 0.7f
+#define SCHED_BOLD_TOLERANCE 0.01f
+#define SCHED_ETA_MIN_RATIO 0.3f	/* of eta0 */
+#define SCHED_ETA_MAX_RATIO 10.0f
+
+void ScheduleInit(tSchedule *sched, int mode, float eta){
+	sched->Mode = (unsigned char)mode;
+	sched->Period = SCHED_STEP_PERIOD;
+	sched->Factor = (mode == SCHED_EXP) ? SCHED_EXP_FACTOR :
+					(mode == SCHED_BOLD) ? SCHED_BOLD_DOWN : SCHED_STEP_FACTOR;
+	sched->Up = SCHED_BOLD_UP;
+	sched->Tolerance = SCHED_BOLD_TOLERANCE;
+	sched->EtaMin = eta*SCHED_ETA_MIN_RATIO;
+	sched->EtaMax = eta*SCHED_ETA_MAX_RATIO;
+	ScheduleReset(sched, eta);
+}
+
+/* Start again from eta, before a new training */
+void ScheduleReset(tSchedule *sched, float eta){
+	sched->Eta0 = eta;
+	sched->Eta = eta;
+	sched->Epoch = 0;
+	sched->LastError = 0;
+}
+
+/*******************************************************/
+/*  After an epoch of error error: eta of the next     */
+/*  epoch                                              */
+/*******************************************************/
+
+float ScheduleUpdate(tSchedule *sched, float error){
+	float eta = sched->Eta;
+
+	sched->Epoch++;
+	switch (sched->Mode){
+	case SCHED_STEP:
+		if ((sched->Epoch % sched->Period) == 0){
+			eta *= sched->Factor;
+		}
+		break;
+	case SCHED_EXP:
+		eta *= sched->Factor;
+		break;
+	case SCHED_BOLD:
+		if (sched->Epoch > 1){
+			if (error < sched->LastError){
+				eta *= sched->Up;
+			}
+			else if (error > sched->LastError*(1+sched->Tolerance)){
+				eta *= sched->Factor;
+			}
+		}
+		break;
+	default:
+		return eta;
+	}
+	if (eta < sched->EtaMin) eta = sched->EtaMin;
+	if (eta > sched->EtaMax) eta = sched->EtaMax;
+	sched->Eta = eta;
+	sched->LastError = error;
+	return eta;
+}
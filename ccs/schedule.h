@@ -0,0 +1,51 @@
+#ifndef SCHEDULE_H_
+#define SCHEDULE_H_
+
+/*****************************************************************************************/
+/* Learning rate schedules                                                               */
+/*                                                                                       */
+/* ScheduleUpdate() is called once after every epoch with the epoch error and returns  */
+/* the eta of the next one, a few float operations per epoch:                            */
+/*                                                                                       */
+/*   SCHED_CONSTANT  eta0                                                                */
+/*   SCHED_STEP      eta times Factor every Period epochs                                */
+/*   SCHED_EXP       eta times Factor every epoch                                        */
+/*   SCHED_BOLD      bold driver: eta times Up while the error goes down, times Factor   */
+/*                   when it goes up by more than Tolerance                              */
+/*                                                                                       */
+/* eta stays within [EtaMin,EtaMax].  The defaults of ScheduleInit() are the ones of     */
+/* bench_schedule; change the fields after it to tune a schedule.                        */
+/*****************************************************************************************/
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#define SCHED_CONSTANT 0
+#define SCHED_STEP 1
+#define SCHED_EXP 2
+#define SCHED_BOLD 3
+#define SCHED_MODES 4
+
+typedef struct {
+	unsigned char Mode;					/* SCHED_CONSTANT ... SCHED_BOLD			*/
+	unsigned long Period;				/* SCHED_STEP: epochs between two steps		*/
+	unsigned long Epoch;				/* epochs since ScheduleInit()/Reset()		*/
+	float Eta0;							/* eta of the first epoch					*/
+	float Eta;							/* eta of the next epoch					*/
+	float Factor;						/* decay, or bold driver decrease			*/
+	float Up;							/* bold driver increase						*/
+	float Tolerance;					/* bold driver: relative error rise that	*/
+										/* is only noise of the online updates		*/
+	float EtaMin, EtaMax;
+	float LastError;					/* error of the previous epoch				*/
+} tSchedule;
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern void ScheduleInit(tSchedule *sched, int mode, float eta);
+extern void ScheduleReset(tSchedule *sched, float eta);
+extern float ScheduleUpdate(tSchedule *sched, float error);
+
+#endif /*SCHEDULE_H_*/
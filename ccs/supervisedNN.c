@@ -24,6 +24,77 @@ double sigmoid(float x) {
 	return result;
 	}
 
+/*******************************************************/
+/*  Table Sigmoid                                      */
+/*  sigmoid(x) sampled on [0,SIGMOID_RANGE] in float   */
+/*  and Q15, linearly interpolated, and mirrored with  */
+/*  sigmoid(-x) = 1-sigmoid(x).  The tables are filled */
+/*  on first use.                                      */
+/*******************************************************/
+
+#if SIGMOID_TABLE_BITS < 4 || SIGMOID_TABLE_BITS > 19
+#error SIGMOID_TABLE_BITS must be 4 to 19: at least one step per unit and a Q15 shift of 0 or more
+#endif
+#define SIGMOID_STEPS_PER_UNIT ((1<<SIGMOID_TABLE_BITS)/SIGMOID_RANGE)
+#define SIGMOID_Q15_SHIFT (15+4-SIGMOID_TABLE_BITS)	/* Q15 to table steps, SIGMOID_RANGE is 2^4 */
+
+static float SigmoidTableF[SIGMOID_TABLE_SIZE];
+static unsigned short SigmoidTableQ[SIGMOID_TABLE_SIZE];
+static short SigmoidTableReady=0;
+
+void SigmoidTableInit(void) {
+	long i;
+	double s;
+
+	for (i=0;i<SIGMOID_TABLE_SIZE;i++){
+		s=1/(1+exp(-(double)i/SIGMOID_STEPS_PER_UNIT));
+		SigmoidTableF[i]=s;
+		SigmoidTableQ[i]=(unsigned short)(s*Q15_ONE+0.5);
+	}
+	SigmoidTableReady=1;
+	}
+
+float sigmoidTable(float x) {
+	float pos;
+	float frac;
+	float result;
+	long i;
+
+	if (!SigmoidTableReady) {SigmoidTableInit();}
+
+	pos=(x<0 ? -x : x)*SIGMOID_STEPS_PER_UNIT;
+	if (pos>=SIGMOID_TABLE_SIZE-1) {
+		result=SigmoidTableF[SIGMOID_TABLE_SIZE-1];
+	}
+	else {
+		i=(long)pos;
+		frac=pos-i;
+		result=SigmoidTableF[i]+frac*(SigmoidTableF[i+1]-SigmoidTableF[i]);
+	}
+	return (x<0 ? 1-result : result);
+	}
+
+long sigmoidQ15(long x) {
+	unsigned long pos;
+	unsigned long frac;
+	long result;
+	long i;
+
+	if (!SigmoidTableReady) {SigmoidTableInit();}
+
+	/**** |x| in table steps with SIGMOID_Q15_SHIFT bits of fraction ******/
+	pos=(x<0 ? -x : x);
+	i=pos>>SIGMOID_Q15_SHIFT;
+	if (i>=SIGMOID_TABLE_SIZE-1) {
+		result=SigmoidTableQ[SIGMOID_TABLE_SIZE-1];
+	}
+	else {
+		frac=pos&((1<<SIGMOID_Q15_SHIFT)-1);
+		result=SigmoidTableQ[i]+(long)(((SigmoidTableQ[i+1]-SigmoidTableQ[i])*frac)>>SIGMOID_Q15_SHIFT);
+	}
+	return (x<0 ? Q15_ONE-result : result);
+	}
+
 float expo(float x) {
 	float result=0;
 	
@@ -45,109 +116,182 @@ float linear(float x) {
 }
 
 /*******************************************************/
-/***********  Forward Algorithm                        */
+/*  Default topology                                   */
+/*  Forward, BackPropagation and the weight            */
+/*  initialization for NumIn x NumHid x NumOut are one  */
+/*  instantiation of the sized network template.       */
+/*******************************************************/
+
+#define NN_NAME XOR
+#define NN_IN   NumIn
+#define NN_HID  NumHid
+#define NN_OUT  NumOut
+#include "supervisedNNSized.h"
 
 void Forward(float inputs[NumIn+1], float InWeights[][NumHid+1], float hidden[NumHid+1], float HidWeights[][NumOut+1], float outputs[NumOut+1]){
-	
-	short i=0;  /* Input layer counter */
-	short j=0;	/* Hidden layer counter */
-	short k=0;	/* Output layer counter */
-	
-	char	str[256];
-	int outputint=0;
+	XORForward(inputs, InWeights, hidden, HidWeights, outputs);
+	}
 
-	/**** compute the hidden layer activation ******/
-	for (j=1;j<=NumHid;j++){
-	hidden[j]=0;   		
-		for (i=0;i<=NumIn;i++) {
-			hidden[j]= hidden[j]+inputs[i]*InWeights[i][j]; 				
-		}
-		hidden[j]= sigmoid(hidden[j]);	
+void ForwardBatch(float patterns[][NumIn], int numPat, float inBias, float hidBias, float InWeights[][NumHid+1], float hidden[][NumHid+1], float HidWeights[][NumOut+1], float outputs[][NumOut+1]){
+	XORForwardBatch(patterns, numPat, inBias, hidBias, InWeights, hidden, HidWeights, outputs);
+	}
 
+void BackPropagation (float target[NumOut+1], float inputs[NumIn+1], float InWeights[][NumHid+1], float hidden[NumHid+1], float HidWeights[][NumOut+1], float outputs[NumOut+1], float eta){
+	XORBackPropagation(target, inputs, InWeights, hidden, HidWeights, outputs, eta);
 	}
-	
-	/**** compute the output layer activation ******/
-	for (k=1;k<=NumOut;k++){  
-	outputs[k]=0;   
-		for (j=0;j<=NumHid;j++){
-			outputs[k]= outputs[k]+hidden[j]*HidWeights[j][k]; 
-		}
-		outputs[k]= sigmoid(outputs[k]);
+
+void AccumulateGradients(float target[NumOut+1], float inputs[NumIn+1], float hidden[NumHid+1], float HidWeights[][NumOut+1], float outputs[NumOut+1], float InGrad[][NumHid+1], float HidGrad[][NumOut+1]){
+	XORAccumulateGradients(target, inputs, hidden, HidWeights, outputs, InGrad, HidGrad);
 	}
-	
+
+void ApplyGradients(float InWeights[][NumHid+1], float HidWeights[][NumOut+1], float InGrad[][NumHid+1], float HidGrad[][NumOut+1], float eta){
+	XORApplyGradients(InWeights, HidWeights, InGrad, HidGrad, eta);
 	}
 
-/*******************************************************/
-/*  Back Propagation Algorithm                         */
-/*******************************************************/
+void AddGradients(float InGrad[][NumHid+1], float HidGrad[][NumOut+1], float InPart[][NumHid+1], float HidPart[][NumOut+1]){
+	XORAddGradients(InGrad, HidGrad, InPart, HidPart);
+	}
 
-void BackPropagation (float target[NumOut+1], float inputs[NumIn+1], float InWeights[][NumHid+1], float hidden[NumHid+1], float HidWeights[][NumOut+1], float outputs[NumOut+1], float eta){
-	short i=0;  /* Input layer counter */
-	short j=0;	/* Hidden layer counter */
-	short k=0;	/* Output layer counter */
-	float DeltaOH[NumOut+1]={0.0};  /* Error from Hidden to Output */
-	float DeltaHI[NumHid+1]={0.0};  /* Error from Input to Hidden */
-	char	str[256];
-	int outputint=0;
-	float temp;
-
-	for (k=1;k<=NumOut;k++){ 
-		DeltaOH[k] = (target[k]-outputs[k]);//*outputs[k]*(1.0-outputs[k]); /* Calculate the Error from Hidden to Output */
-		for (j=0;j<=NumHid;j++){
-			HidWeights[j][k] = HidWeights[j][k] + eta*DeltaOH[k]*hidden[j];/* Update the Hidden Layer Weights*/
-				
-		}
+float TrainEpoch(float patterns[][NumIn], float targets[], int numPat, int batchSize, float inBias, float hidBias, float InWeights[][NumHid+1], float HidWeights[][NumOut+1], float InGrad[][NumHid+1], float HidGrad[][NumOut+1], float eta){
+	return XORTrainEpoch(patterns, targets, numPat, batchSize, inBias, hidBias, InWeights, HidWeights, InGrad, HidGrad, eta);
 	}
-					
-				
-	for (j=1;j<=NumHid;j++){
-		for (k=1;k<=NumOut;k++){						
-			DeltaHI[j]=DeltaHI[j]+HidWeights[j][k]*DeltaOH[k];		/* Backpropagate the Error */ 
-		}
-		DeltaHI[j]= DeltaHI[j]*hidden[j]*(1-hidden[j]);			/* Calculate the Error from Input to Hidden */				
-		for (i=0;i<=NumIn;i++) {
-			InWeights[i][j] =InWeights[i][j] + eta*DeltaHI[j]*inputs[i]; /* Update the Input Layer Weights */
-			  
-		}				
-	}	
+
+float TrainEpochOrder(float patterns[][NumIn], float targets[], const unsigned short order[], int numPat, int batchSize, float inBias, float hidBias, float InWeights[][NumHid+1], float HidWeights[][NumOut+1], float InGrad[][NumHid+1], float HidGrad[][NumOut+1], float eta){
+	return XORTrainEpochOrder(patterns, targets, order, numPat, batchSize, inBias, hidBias, InWeights, HidWeights, InGrad, HidGrad, eta);
 	}
 
-/*******************************************************/
-/*  Input Weights Initialization                       */
-/*******************************************************/
+int OptimizerWeights(tOptimizer *opt, tOptArena *arena){
+	return XOROptimizerWeights(opt, arena);
+	}
+
+void ApplyGradientsOpt(float InWeights[][NumHid+1], float HidWeights[][NumOut+1], float InGrad[][NumHid+1], float HidGrad[][NumOut+1], tOptimizer *opt){
+	XORApplyGradientsOpt(InWeights, HidWeights, InGrad, HidGrad, opt);
+	}
+
+float TrainEpochOpt(float patterns[][NumIn], float targets[], const unsigned short order[], int numPat, int batchSize, float inBias, float hidBias, float InWeights[][NumHid+1], float HidWeights[][NumOut+1], float InGrad[][NumHid+1], float HidGrad[][NumOut+1], tOptimizer *opt){
+	return XORTrainEpochOpt(patterns, targets, order, numPat, batchSize, inBias, hidBias, InWeights, HidWeights, InGrad, HidGrad, opt);
+	}
 
 void InWeightsInit(float InWeights[][NumHid+1]){
-	short i=0;  /* Input layer counter */
-	short j=0;	/* Hidden layer counter */
-	
-	for(j=0;j<=NumHid;j++){
-		for(i=0;i<=NumIn;i++){
-			InWeights[i][j]=getrandom_f(-1.0,1.0);
-		}
+	XORInWeightsInit(InWeights);
 	}
-	
+
+void HidWeightsInit(float HidWeights[][NumOut+1]){
+	XORHidWeightsInit(HidWeights);
+	}
+
+void InWeightsInitMode(float InWeights[][NumHid+1], int mode){
+	XORInWeightsInitMode(InWeights, mode);
+	}
+
+void HidWeightsInitMode(float HidWeights[][NumOut+1], int mode){
+	XORHidWeightsInitMode(HidWeights, mode);
 	}
 
 /*******************************************************/
-/*  Hidden Weights Initialization                      */
+/*  Random Number Generator                            */
+/*  NNRandom starts in the state of                    */
+/*  PRNGSeed(&NNRandom, 0), reseed it for another run. */
 /*******************************************************/
 
-void HidWeightsInit(float HidWeights[][NumOut+1]){
-	short j=0;	/* Hidden layer counter */
-	short k=0;	/* Output layer counter */
-	for(k=0;k<=NumOut;k++){
-		for(j=0;j<=NumHid;j++){
-			HidWeights[j][k]=getrandom_f(-1.0,1.0);
+tPRNG NNRandom = {{0x01FCE552, 0x04F8D29E, 0x0F8C1DBD, 0x6BA5A157}};
+
+float getrandom_f(float min,float max){
+	return PRNGFloat(&NNRandom, min, max);
+}
+
+/*******************************************************/
+/*  Weights Initialization Strategies                  */
+/*  The weight from input i (0 is the bias) to output  */
+/*  j (from 0) of a layer is                           */
+/*  weights[i*inStride+j*outStride], which covers the  */
+/*  [from][to] arrays of the sized networks and the    */
+/*  [to][from] layers of the stack.  Draws from        */
+/*  NNRandom, see INIT_UNIFORM... in supervisedNN.h.   */
+/*******************************************************/
+
+/* Orthonormal columns by modified Gram-Schmidt on a normal matrix, in place */
+static void WeightsOrthogonal(float *weights, int n, int inStride, int outStride){
+	float dot, norm;
+	int i,j,k;
+
+	for (j=0;j<n;j++){
+		weights[j*outStride]=0;		/* bias */
+		for (i=1;i<=n;i++){
+			weights[i*inStride+j*outStride]=PRNGNormal(&NNRandom);
+		}
+	}
+	for (j=0;j<n;j++){
+		for (k=0;k<j;k++){
+			dot=0;
+			for (i=1;i<=n;i++){
+				dot+=weights[i*inStride+j*outStride]*weights[i*inStride+k*outStride];
+			}
+			for (i=1;i<=n;i++){
+				weights[i*inStride+j*outStride]-=dot*weights[i*inStride+k*outStride];
+			}
+		}
+		norm=0;
+		for (i=1;i<=n;i++){
+			norm+=weights[i*inStride+j*outStride]*weights[i*inStride+j*outStride];
+		}
+		norm=(norm>0 ? 1.0f/sqrtf(norm) : 0);
+		for (i=1;i<=n;i++){
+			weights[i*inStride+j*outStride]*=norm;
 		}
 	}
+}
+
+void WeightsInit(float *weights, int fanIn, int fanOut, int inStride, int outStride, int mode){
+	float n = (float)(fanIn+1);
+	float m = (float)fanOut;
+	float scale;
+	int normal;
+	int i,j;
+
+	switch (mode){
+		case INIT_XAVIER:			scale=sqrtf(6.0f/(n+m));	normal=0;	break;
+		case INIT_HE:				scale=sqrtf(6.0f/n);		normal=0;	break;
+		case INIT_HE_NORMAL:		scale=sqrtf(2.0f/n);		normal=1;	break;
+		case INIT_ORTHOGONAL:
+			if (fanIn==fanOut){
+				WeightsOrthogonal(weights, fanIn, inStride, outStride);
+				return;
+			}
+			/* not square, fall through */
+		case INIT_XAVIER_NORMAL:	scale=sqrtf(2.0f/(n+m));	normal=1;	break;
+		default:					scale=1.0f;					normal=0;	break;
+	}
+	for (j=0;j<fanOut;j++){
+		for (i=0;i<=fanIn;i++){
+			weights[i*inStride+j*outStride] = normal ? scale*PRNGNormal(&NNRandom) : PRNGFloat(&NNRandom, -scale, scale);
+		}
 	}
+}
 
 /*******************************************************/
-/*  Random Number Generator                            */
+/*  Pattern Order                                      */
+/*  Fills order[0..numPat-1] with the patterns of the  */
+/*  next epoch (ORDER_FIXED, ORDER_SHUFFLE or          */
+/*  ORDER_SAMPLE), drawing from NNRandom.              */
 /*******************************************************/
 
-float getrandom_f(float min,float max){
-	return min + (rand()*(max-min)/(RAND_MAX + 1));
+void PatternOrder(unsigned short order[], int numPat, int mode){
+	int p;
+
+	switch (mode){
+		case ORDER_SHUFFLE:
+			PRNGPermutation(&NNRandom, order, numPat);
+			break;
+		case ORDER_SAMPLE:
+			PRNGSample(&NNRandom, order, numPat, numPat);
+			break;
+		default:
+			for (p=0;p<numPat;p++){
+				order[p]=(unsigned short)p;
+			}
+			break;
+	}
 }
 
 void test(float array1[3], float array2[][3], float in){
@@ -1,26 +1,89 @@
 #ifndef SUPERVISEDNN_H_
 #define SUPERVISEDNN_H_
 
+#include "prng.h"
+#include "optimizer.h"
+
 /************************************/
 /*	Definitions       				*/
 /************************************/
+/* Default topology used by Forward() and BackPropagation().    */
+/* Other sizes are generated with supervisedNNSized.h.           */
 #define NumIn 2
 #define NumHid 2
 #define NumOut 1
 #define NumLayers 3
 #define NumPat 4
 
+/* Sigmoid used by the networks (NN_SIGMOID).                   */
+/*   SIGMOID_EXACT  double precision exp(), reference           */
+/*   SIGMOID_TABLE  interpolated table, no exp() at run time    */
+/* The table holds 2^SIGMOID_TABLE_BITS+1 samples of            */
+/* [0,SIGMOID_RANGE]: 8 bits keep the error below 5e-5 in float */
+/* and 1e-4 in Q15, 6 bits below 8e-4.                          */
+#define SIGMOID_EXACT 0
+#define SIGMOID_TABLE 1
+#ifndef SIGMOID_MODE
+#define SIGMOID_MODE SIGMOID_TABLE
+#endif
+#ifndef SIGMOID_TABLE_BITS
+#define SIGMOID_TABLE_BITS 8
+#endif
+#define SIGMOID_RANGE 16
+#define SIGMOID_TABLE_SIZE ((1<<SIGMOID_TABLE_BITS)+1)
+
+#if SIGMOID_MODE == SIGMOID_TABLE
+#define NN_SIGMOID(x) sigmoidTable(x)
+#else
+#define NN_SIGMOID(x) sigmoid(x)
+#endif
+
+/* Pattern order of a training epoch (PatternOrder())          */
+#define ORDER_FIXED 0		/* 0..numPat-1, every epoch the same    */
+#define ORDER_SHUFFLE 1		/* a new permutation every epoch        */
+#define ORDER_SAMPLE 2		/* numPat draws with replacement        */
+
+/* Weights initialization of a layer (WeightsInit()), n is the */
+/* fan-in with the bias and m the fan-out                       */
+#define INIT_UNIFORM 0			/* uniform in [-1,1]                    */
+#define INIT_XAVIER 1			/* uniform, +-sqrt(6/(n+m))             */
+#define INIT_XAVIER_NORMAL 2	/* normal, sd sqrt(2/(n+m))             */
+#define INIT_HE 3				/* uniform, +-sqrt(6/n)                 */
+#define INIT_HE_NORMAL 4		/* normal, sd sqrt(2/n)                 */
+#define INIT_ORTHOGONAL 5		/* orthonormal, zero bias, square       */
+								/* layers only, else INIT_XAVIER_NORMAL */
+
+/* Fixed point: Q15 values are held in a long, 1.0 = 1<<15 */
+#define Q15_ONE 32768L
+
 /************************************/
 /*	Prototype       				*/
 /************************************/
 
 extern double sigmoid(float x);
+extern float sigmoidTable(float x);
+extern long sigmoidQ15(long x);
+extern void SigmoidTableInit(void);
 extern float linear(float x);
 extern float devsigmoid(float x);
 extern void Forward(float inputs[NumIn+1], float InWeights[][NumHid+1], float hidden[NumHid+1], float HidWeights[][NumOut+1], float outputs[NumOut+1]);
+extern void ForwardBatch(float patterns[][NumIn], int numPat, float inBias, float hidBias, float InWeights[][NumHid+1], float hidden[][NumHid+1], float HidWeights[][NumOut+1], float outputs[][NumOut+1]);
 extern void BackPropagation (float target[NumOut+1], float inputs[NumIn+1], float InWeights[][NumHid+1], float hidden[NumHid+1], float HidWeights[][NumOut+1], float outputs[NumOut+1], float eta);
+extern void AccumulateGradients(float target[NumOut+1], float inputs[NumIn+1], float hidden[NumHid+1], float HidWeights[][NumOut+1], float outputs[NumOut+1], float InGrad[][NumHid+1], float HidGrad[][NumOut+1]);
+extern void ApplyGradients(float InWeights[][NumHid+1], float HidWeights[][NumOut+1], float InGrad[][NumHid+1], float HidGrad[][NumOut+1], float eta);
+extern void AddGradients(float InGrad[][NumHid+1], float HidGrad[][NumOut+1], float InPart[][NumHid+1], float HidPart[][NumOut+1]);
+extern float TrainEpoch(float patterns[][NumIn], float targets[], int numPat, int batchSize, float inBias, float hidBias, float InWeights[][NumHid+1], float HidWeights[][NumOut+1], float InGrad[][NumHid+1], float HidGrad[][NumOut+1], float eta);
+extern float TrainEpochOrder(float patterns[][NumIn], float targets[], const unsigned short order[], int numPat, int batchSize, float inBias, float hidBias, float InWeights[][NumHid+1], float HidWeights[][NumOut+1], float InGrad[][NumHid+1], float HidGrad[][NumOut+1], float eta);
+extern int OptimizerWeights(tOptimizer *opt, tOptArena *arena);
+extern void ApplyGradientsOpt(float InWeights[][NumHid+1], float HidWeights[][NumOut+1], float InGrad[][NumHid+1], float HidGrad[][NumOut+1], tOptimizer *opt);
+extern float TrainEpochOpt(float patterns[][NumIn], float targets[], const unsigned short order[], int numPat, int batchSize, float inBias, float hidBias, float InWeights[][NumHid+1], float HidWeights[][NumOut+1], float InGrad[][NumHid+1], float HidGrad[][NumOut+1], tOptimizer *opt);
+extern void PatternOrder(unsigned short order[], int numPat, int mode);
 extern void InWeightsInit(float InWeights[][NumHid+1]);
 extern void HidWeightsInit(float HidWeights[][NumOut+1]);
+extern void InWeightsInitMode(float InWeights[][NumHid+1], int mode);
+extern void HidWeightsInitMode(float HidWeights[][NumOut+1], int mode);
+extern void WeightsInit(float *weights, int fanIn, int fanOut, int inStride, int outStride, int mode);
+extern tPRNG NNRandom;		/* weights initialization, seed with PRNGSeed() */
 extern float getrandom_f(float min,float max);
 extern void test(float array1[3], float array2[][3], float in);
 
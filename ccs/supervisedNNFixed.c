@@ -0,0 +1,76 @@
+/*****************************************************************************************/
+/* Fixed point Neural Network                                                            */
+/*                                                                                       */
+/* Conversions between float and Q15 and the Q15 network for the default topology,       */
+/* generated from the sized network template.                                            */
+/*****************************************************************************************/
+
+#include "supervisedNNFixed.h"
+
+#define NN_NAME XOR
+#define NN_IN   NumIn
+#define NN_HID  NumHid
+#define NN_OUT  NumOut
+#include "supervisedNNSized.h"
+
+/*******************************************************/
+/*  Conversions                                        */
+/*******************************************************/
+
+long FloatToQ15(float x){
+	float q = x*Q15_ONE;
+
+	if (q>=2147483647.0f) {return Q15_MAX;}
+	if (q<=-2147483648.0f) {return Q15_MIN;}
+	return (long)(q<0 ? q-0.5f : q+0.5f);
+}
+
+float Q15ToFloat(long x){
+	return (float)x/Q15_ONE;
+}
+
+void FloatArrayToQ15(long *dst, const float *src, unsigned long n){
+	while (n--) {
+		*dst++=FloatToQ15(*src++);
+	}
+}
+
+void Q15ArrayToFloat(float *dst, const long *src, unsigned long n){
+	while (n--) {
+		*dst++=Q15ToFloat(*src++);
+	}
+}
+
+void WeightsToQ15(float InWeights[][NumHid+1], float HidWeights[][NumOut+1], long InWeightsQ[][NumHid+1], long HidWeightsQ[][NumOut+1]){
+	FloatArrayToQ15(&InWeightsQ[0][0], &InWeights[0][0], (NumIn+1)*(NumHid+1));
+	FloatArrayToQ15(&HidWeightsQ[0][0], &HidWeights[0][0], (NumHid+1)*(NumOut+1));
+}
+
+void WeightsFromQ15(long InWeightsQ[][NumHid+1], long HidWeightsQ[][NumOut+1], float InWeights[][NumHid+1], float HidWeights[][NumOut+1]){
+	Q15ArrayToFloat(&InWeights[0][0], &InWeightsQ[0][0], (NumIn+1)*(NumHid+1));
+	Q15ArrayToFloat(&HidWeights[0][0], &HidWeightsQ[0][0], (NumHid+1)*(NumOut+1));
+}
+
+/*******************************************************/
+/*  Default topology                                   */
+/*******************************************************/
+
+void ForwardQ15(long inputs[NumIn+1], long InWeights[][NumHid+1], long hidden[NumHid+1], long HidWeights[][NumOut+1], long outputs[NumOut+1]){
+	XORForwardQ15(inputs, InWeights, hidden, HidWeights, outputs);
+}
+
+void BackPropagationQ15(long target[NumOut+1], long inputs[NumIn+1], long InWeights[][NumHid+1], long hidden[NumHid+1], long HidWeights[][NumOut+1], long outputs[NumOut+1], long eta){
+	XORBackPropagationQ15(target, inputs, InWeights, hidden, HidWeights, outputs, eta);
+}
+
+void AccumulateGradientsQ15(long target[NumOut+1], long inputs[NumIn+1], long hidden[NumHid+1], long HidWeights[][NumOut+1], long outputs[NumOut+1], long InGrad[][NumHid+1], long HidGrad[][NumOut+1]){
+	XORAccumulateGradientsQ15(target, inputs, hidden, HidWeights, outputs, InGrad, HidGrad);
+}
+
+void ApplyGradientsOptQ15(long InWeights[][NumHid+1], long HidWeights[][NumOut+1], long InGrad[][NumHid+1], long HidGrad[][NumOut+1], tOptimizer *opt){
+	XORApplyGradientsOptQ15(InWeights, HidWeights, InGrad, HidGrad, opt);
+}
+
+long TrainEpochOptQ15(long patterns[][NumIn], long targets[], const unsigned short order[], int numPat, int batchSize, long inBias, long hidBias, long InWeights[][NumHid+1], long HidWeights[][NumOut+1], long InGrad[][NumHid+1], long HidGrad[][NumOut+1], tOptimizer *opt){
+	return XORTrainEpochOptQ15(patterns, targets, order, numPat, batchSize, inBias, hidBias, InWeights, HidWeights, InGrad, HidGrad, opt);
+}
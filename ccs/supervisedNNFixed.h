@@ -0,0 +1,58 @@
+#ifndef SUPERVISEDNNFIXED_H_
+#define SUPERVISEDNNFIXED_H_
+
+/*****************************************************************************************/
+/* Fixed point Neural Network                                                            */
+/*                                                                                       */
+/* Weights, activations, deltas and eta are Q15 numbers held in a 32 bit long            */
+/* (1.0 = Q15_ONE, range +-65536).  Products are accumulated in 64 bits, which is a      */
+/* single SMLAL on the Cortex-M3, then rounded and saturated back to 32 bits, so the     */
+/* network never wraps around.  No floating point is used by ForwardQ15() and            */
+/* BackPropagationQ15(); the float helpers are only for conversion.                      */
+/*****************************************************************************************/
+
+#include "supervisedNN.h"
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#define Q15_MAX 0x7FFFFFFFL
+#define Q15_MIN (-0x7FFFFFFFL-1)
+
+/************************************/
+/*	Q15 arithmetic     				*/
+/************************************/
+
+/* Saturate a 64 bit value to 32 bits */
+static __inline long Q15Sat(long long x){
+	return (x>Q15_MAX ? Q15_MAX : (x<Q15_MIN ? Q15_MIN : (long)x));
+}
+
+/* Rounded, saturated Q15 product */
+static __inline long Q15Mul(long a, long b){
+	return Q15Sat(((long long)a*b+(1<<14))>>15);
+}
+
+/* Saturated Q15 sum */
+static __inline long Q15Add(long a, long b){
+	return Q15Sat((long long)a+b);
+}
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern long FloatToQ15(float x);
+extern float Q15ToFloat(long x);
+extern void FloatArrayToQ15(long *dst, const float *src, unsigned long n);
+extern void Q15ArrayToFloat(float *dst, const long *src, unsigned long n);
+extern void WeightsToQ15(float InWeights[][NumHid+1], float HidWeights[][NumOut+1], long InWeightsQ[][NumHid+1], long HidWeightsQ[][NumOut+1]);
+extern void WeightsFromQ15(long InWeightsQ[][NumHid+1], long HidWeightsQ[][NumOut+1], float InWeights[][NumHid+1], float HidWeights[][NumOut+1]);
+extern void ForwardQ15(long inputs[NumIn+1], long InWeights[][NumHid+1], long hidden[NumHid+1], long HidWeights[][NumOut+1], long outputs[NumOut+1]);
+extern void BackPropagationQ15(long target[NumOut+1], long inputs[NumIn+1], long InWeights[][NumHid+1], long hidden[NumHid+1], long HidWeights[][NumOut+1], long outputs[NumOut+1], long eta);
+
+extern void AccumulateGradientsQ15(long target[NumOut+1], long inputs[NumIn+1], long hidden[NumHid+1], long HidWeights[][NumOut+1], long outputs[NumOut+1], long InGrad[][NumHid+1], long HidGrad[][NumOut+1]);
+extern void ApplyGradientsOptQ15(long InWeights[][NumHid+1], long HidWeights[][NumOut+1], long InGrad[][NumHid+1], long HidGrad[][NumOut+1], tOptimizer *opt);
+extern long TrainEpochOptQ15(long patterns[][NumIn], long targets[], const unsigned short order[], int numPat, int batchSize, long inBias, long hidBias, long InWeights[][NumHid+1], long HidWeights[][NumOut+1], long InGrad[][NumHid+1], long HidGrad[][NumOut+1], tOptimizer *opt);
+
+#endif /*SUPERVISEDNNFIXED_H_*/
@@ -0,0 +1,515 @@
+/*****************************************************************************************/
+/* Compile-time sized Neural Network                                                     */
+/*                                                                                       */
+/* This header is a template: it has no include guard and generates a complete 3 layer   */
+/* network (types, Forward, BackPropagation and weight initialization) for the topology  */
+/* given by the macros below, every time it is included.  All loop bounds are constants, */
+/* so the compiler fully unrolls the loops of small networks and keeps the activations   */
+/* in registers; the generated code is the same as hand-sized arrays.  Any number of     */
+/* topologies can coexist in one program as long as each one has its own NN_NAME.        */
+/*                                                                                       */
+/*    #define NN_NAME  Sensor      prefix of every generated type and function           */
+/*    #define NN_IN    8           number of inputs (without the bias)                   */
+/*    #define NN_HID   6           number of hidden neurons (without the bias)           */
+/*    #define NN_OUT   3           number of outputs                                     */
+/*    #include "supervisedNNSized.h"                                                     */
+/*                                                                                       */
+/* generates SensorNet, SensorForward(), SensorBackPropagation(), SensorNetForward() ... */
+/* the batch training SensorTrainEpoch(), SensorAccumulateGradients() ..., the training  */
+/* with an optimizer SensorTrainEpochOpt() (optimizer.h) and the Q15 variants            */
+/* SensorForwardQ15(), SensorBackPropagationQ15() and SensorTrainEpochOptQ15().          */
+/* The functions are static __inline unless NN_STORAGE is defined before the include.    */
+/* The parameter macros are undefined at the end so the header can be included again.    */
+/*****************************************************************************************/
+
+#include "supervisedNN.h"
+#include "supervisedNNFixed.h"
+
+#if !defined(NN_NAME) || !defined(NN_IN) || !defined(NN_HID) || !defined(NN_OUT)
+#error "define NN_NAME, NN_IN, NN_HID and NN_OUT before including supervisedNNSized.h"
+#endif
+
+#ifndef NN_STORAGE
+#define NN_STORAGE static __inline
+#endif
+
+#ifndef NN_SIZED_HELPERS_
+#define NN_SIZED_HELPERS_
+#define NN_CAT_(a, b) a##b
+#define NN_CAT(a, b) NN_CAT_(a, b)
+#define NN_FN(name) NN_CAT(NN_NAME, name)
+#endif
+
+/*******************************************************/
+/*  Network type: activations and weights              */
+/*  Index 0 of Inputs and Hidden holds the bias.       */
+/*******************************************************/
+
+typedef struct {
+	float Inputs[NN_IN+1];
+	float Hidden[NN_HID+1];
+	float Outputs[NN_OUT+1];
+	float InWeights[NN_IN+1][NN_HID+1];
+	float HidWeights[NN_HID+1][NN_OUT+1];
+} NN_FN(Net);
+
+/*******************************************************/
+/***********  Forward Algorithm                        */
+
+NN_STORAGE void NN_FN(Forward)(float inputs[NN_IN+1], float InWeights[][NN_HID+1], float hidden[NN_HID+1], float HidWeights[][NN_OUT+1], float outputs[NN_OUT+1]){
+	int i;	/* Input layer counter */
+	int j;	/* Hidden layer counter */
+	int k;	/* Output layer counter */
+	float sum;
+
+	/**** compute the hidden layer activation ******/
+	for (j=1;j<=NN_HID;j++){
+		sum=0;
+		for (i=0;i<=NN_IN;i++) {
+			sum+=inputs[i]*InWeights[i][j];
+		}
+		hidden[j]= NN_SIGMOID(sum);
+	}
+
+	/**** compute the output layer activation ******/
+	for (k=1;k<=NN_OUT;k++){
+		sum=0;
+		for (j=0;j<=NN_HID;j++){
+			sum+=hidden[j]*HidWeights[j][k];
+		}
+		outputs[k]= NN_SIGMOID(sum);
+	}
+}
+
+/*******************************************************/
+/*  Batched Forward Algorithm                          */
+/*  Evaluates numPat patterns (inputs without bias) in */
+/*  one pass.  Each neuron's weights and bias term are */
+/*  loaded once and reused for every pattern.  hidden  */
+/*  and outputs get one row per pattern, indexed like  */
+/*  Forward(), so they can feed BackPropagation().     */
+/*******************************************************/
+
+NN_STORAGE void NN_FN(ForwardBatch)(float patterns[][NN_IN], int numPat, float inBias, float hidBias, float InWeights[][NN_HID+1], float hidden[][NN_HID+1], float HidWeights[][NN_OUT+1], float outputs[][NN_OUT+1]){
+	int i,j,k,p;
+	float wIn[NN_IN+1];
+	float wHid[NN_HID+1];
+	float sum;
+
+	for (j=1;j<=NN_HID;j++){
+		for (i=1;i<=NN_IN;i++){
+			wIn[i]=InWeights[i][j];
+		}
+		wIn[0]=inBias*InWeights[0][j];
+		for (p=0;p<numPat;p++){
+			sum=wIn[0];
+			for (i=1;i<=NN_IN;i++){
+				sum+=patterns[p][i-1]*wIn[i];
+			}
+			hidden[p][j]=NN_SIGMOID(sum);
+		}
+	}
+
+	for (k=1;k<=NN_OUT;k++){
+		for (j=1;j<=NN_HID;j++){
+			wHid[j]=HidWeights[j][k];
+		}
+		wHid[0]=hidBias*HidWeights[0][k];
+		for (p=0;p<numPat;p++){
+			hidden[p][0]=hidBias;
+			sum=wHid[0];
+			for (j=1;j<=NN_HID;j++){
+				sum+=hidden[p][j]*wHid[j];
+			}
+			outputs[p][k]=NN_SIGMOID(sum);
+		}
+	}
+}
+
+/*******************************************************/
+/*  Back Propagation Algorithm                         */
+/*******************************************************/
+
+NN_STORAGE void NN_FN(BackPropagation)(float target[NN_OUT+1], float inputs[NN_IN+1], float InWeights[][NN_HID+1], float hidden[NN_HID+1], float HidWeights[][NN_OUT+1], float outputs[NN_OUT+1], float eta){
+	int i;	/* Input layer counter */
+	int j;	/* Hidden layer counter */
+	int k;	/* Output layer counter */
+	float DeltaOH[NN_OUT+1];	/* Error from Hidden to Output */
+	float DeltaHI;				/* Error from Input to Hidden */
+
+	for (k=1;k<=NN_OUT;k++){
+		DeltaOH[k] = (target[k]-outputs[k]);	/* Calculate the Error from Hidden to Output */
+		for (j=0;j<=NN_HID;j++){
+			HidWeights[j][k] += eta*DeltaOH[k]*hidden[j];	/* Update the Hidden Layer Weights*/
+		}
+	}
+
+	for (j=1;j<=NN_HID;j++){
+		DeltaHI=0;
+		for (k=1;k<=NN_OUT;k++){
+			DeltaHI+=HidWeights[j][k]*DeltaOH[k];	/* Backpropagate the Error */
+		}
+		DeltaHI*=hidden[j]*(1-hidden[j]);			/* Calculate the Error from Input to Hidden */
+		for (i=0;i<=NN_IN;i++) {
+			InWeights[i][j] += eta*DeltaHI*inputs[i];	/* Update the Input Layer Weights */
+		}
+	}
+}
+
+/*******************************************************/
+/*  Gradient accumulation (mini-batch / full-batch)    */
+/*  AccumulateGradients adds the gradient of one       */
+/*  pattern to InGrad/HidGrad without touching the     */
+/*  weights; ApplyGradients adds eta times the sum to  */
+/*  the weights and clears it.  Partial sums computed  */
+/*  in parallel are combined with AddGradients.        */
+/*******************************************************/
+
+NN_STORAGE void NN_FN(AccumulateGradients)(float target[NN_OUT+1], float inputs[NN_IN+1], float hidden[NN_HID+1], float HidWeights[][NN_OUT+1], float outputs[NN_OUT+1], float InGrad[][NN_HID+1], float HidGrad[][NN_OUT+1]){
+	int i,j,k;
+	float DeltaOH[NN_OUT+1];
+	float DeltaHI;
+
+	for (k=1;k<=NN_OUT;k++){
+		DeltaOH[k] = (target[k]-outputs[k]);
+		for (j=0;j<=NN_HID;j++){
+			HidGrad[j][k] += DeltaOH[k]*hidden[j];
+		}
+	}
+
+	for (j=1;j<=NN_HID;j++){
+		DeltaHI=0;
+		for (k=1;k<=NN_OUT;k++){
+			DeltaHI+=HidWeights[j][k]*DeltaOH[k];
+		}
+		DeltaHI*=hidden[j]*(1-hidden[j]);
+		for (i=0;i<=NN_IN;i++) {
+			InGrad[i][j] += DeltaHI*inputs[i];
+		}
+	}
+}
+
+NN_STORAGE void NN_FN(ApplyGradients)(float InWeights[][NN_HID+1], float HidWeights[][NN_OUT+1], float InGrad[][NN_HID+1], float HidGrad[][NN_OUT+1], float eta){
+	int i,j,k;
+
+	for (j=1;j<=NN_HID;j++){
+		for (i=0;i<=NN_IN;i++){
+			InWeights[i][j] += eta*InGrad[i][j];
+			InGrad[i][j] = 0;
+		}
+	}
+	for (k=1;k<=NN_OUT;k++){
+		for (j=0;j<=NN_HID;j++){
+			HidWeights[j][k] += eta*HidGrad[j][k];
+			HidGrad[j][k] = 0;
+		}
+	}
+}
+
+NN_STORAGE void NN_FN(AddGradients)(float InGrad[][NN_HID+1], float HidGrad[][NN_OUT+1], float InPart[][NN_HID+1], float HidPart[][NN_OUT+1]){
+	int i,j,k;
+
+	for (j=1;j<=NN_HID;j++){
+		for (i=0;i<=NN_IN;i++){
+			InGrad[i][j] += InPart[i][j];
+		}
+	}
+	for (k=1;k<=NN_OUT;k++){
+		for (j=0;j<=NN_HID;j++){
+			HidGrad[j][k] += HidPart[j][k];
+		}
+	}
+}
+
+/*******************************************************/
+/*  Training epoch                                     */
+/*  Presents numPat patterns (inputs without bias,     */
+/*  targets numPat*NN_OUT values) and returns the      */
+/*  epoch error sum(0.5*(target-output)^2).  The       */
+/*  patterns are taken in the order given by order[]   */
+/*  (see PatternOrder()), or 0..numPat-1 if it is 0.   */
+/*  batchSize<=1 is online training (BackPropagation   */
+/*  after every pattern); otherwise the gradients are  */
+/*  applied every batchSize patterns and at the end,   */
+/*  so batchSize>=numPat is deterministic full-batch.  */
+/*******************************************************/
+
+NN_STORAGE float NN_FN(TrainEpochOrder)(float patterns[][NN_IN], float targets[], const unsigned short order[], int numPat, int batchSize, float inBias, float hidBias, float InWeights[][NN_HID+1], float HidWeights[][NN_OUT+1], float InGrad[][NN_HID+1], float HidGrad[][NN_OUT+1], float eta){
+	float inputs[NN_IN+1];
+	float hidden[NN_HID+1];
+	float outputs[NN_OUT+1];
+	float target[NN_OUT+1];
+	float error=0;
+	float e;
+	int i,k,m,p;
+	int n=0;
+
+	inputs[0]=inBias;
+	hidden[0]=hidBias;
+	for (m=0;m<numPat;m++){
+		p = order ? order[m] : m;
+		for (i=1;i<=NN_IN;i++){
+			inputs[i]=patterns[p][i-1];
+		}
+		for (k=1;k<=NN_OUT;k++){
+			target[k]=targets[p*NN_OUT+k-1];
+		}
+		NN_FN(Forward)(inputs, InWeights, hidden, HidWeights, outputs);
+		for (k=1;k<=NN_OUT;k++){
+			e=target[k]-outputs[k];
+			error+=0.5f*e*e;
+		}
+		if (batchSize<=1){
+			NN_FN(BackPropagation)(target, inputs, InWeights, hidden, HidWeights, outputs, eta);
+		}
+		else {
+			NN_FN(AccumulateGradients)(target, inputs, hidden, HidWeights, outputs, InGrad, HidGrad);
+			if ((++n==batchSize) || (m==numPat-1)){
+				NN_FN(ApplyGradients)(InWeights, HidWeights, InGrad, HidGrad, eta);
+				n=0;
+			}
+		}
+	}
+	return error;
+}
+
+NN_STORAGE float NN_FN(TrainEpoch)(float patterns[][NN_IN], float targets[], int numPat, int batchSize, float inBias, float hidBias, float InWeights[][NN_HID+1], float HidWeights[][NN_OUT+1], float InGrad[][NN_HID+1], float HidGrad[][NN_OUT+1], float eta){
+	return NN_FN(TrainEpochOrder)(patterns, targets, 0, numPat, batchSize, inBias, hidBias, InWeights, HidWeights, InGrad, HidGrad, eta);
+}
+
+/*******************************************************/
+/*  Training with an optimizer (optimizer.h)           */
+/*  OptimizerWeights registers InWeights and           */
+/*  HidWeights as the parameters 0 and 1 of opt, with  */
+/*  their state in arena, and returns 0 or -1 if the   */
+/*  arena is too small.  ApplyGradientsOpt is one      */
+/*  update of opt.  TrainEpochOpt is TrainEpochOrder   */
+/*  with the updates of opt, every pattern when        */
+/*  batchSize<=1.  OPT_SGD keeps the BackPropagation   */
+/*  and ApplyGradients of TrainEpochOrder.             */
+/*******************************************************/
+
+NN_STORAGE int NN_FN(OptimizerWeights)(tOptimizer *opt, tOptArena *arena){
+	if (OptimizerAdd(opt, arena, (NN_IN+1)*(NN_HID+1)) < 0){
+		return -1;
+	}
+	return (OptimizerAdd(opt, arena, (NN_HID+1)*(NN_OUT+1)) < 0) ? -1 : 0;
+}
+
+NN_STORAGE void NN_FN(ApplyGradientsOpt)(float InWeights[][NN_HID+1], float HidWeights[][NN_OUT+1], float InGrad[][NN_HID+1], float HidGrad[][NN_OUT+1], tOptimizer *opt){
+	OptimizerBegin(opt);
+	OptimizerApply(opt, 0, &InWeights[0][0], &InGrad[0][0]);
+	OptimizerApply(opt, 1, &HidWeights[0][0], &HidGrad[0][0]);
+}
+
+NN_STORAGE float NN_FN(TrainEpochOpt)(float patterns[][NN_IN], float targets[], const unsigned short order[], int numPat, int batchSize, float inBias, float hidBias, float InWeights[][NN_HID+1], float HidWeights[][NN_OUT+1], float InGrad[][NN_HID+1], float HidGrad[][NN_OUT+1], tOptimizer *opt){
+	float inputs[NN_IN+1];
+	float hidden[NN_HID+1];
+	float outputs[NN_OUT+1];
+	float target[NN_OUT+1];
+	float error=0;
+	float e;
+	int i,k,m,p;
+	int n=0;
+
+	if (opt->Method==OPT_SGD){
+		return NN_FN(TrainEpochOrder)(patterns, targets, order, numPat, batchSize, inBias, hidBias, InWeights, HidWeights, InGrad, HidGrad, opt->Eta);
+	}
+	inputs[0]=inBias;
+	hidden[0]=hidBias;
+	for (m=0;m<numPat;m++){
+		p = order ? order[m] : m;
+		for (i=1;i<=NN_IN;i++){
+			inputs[i]=patterns[p][i-1];
+		}
+		for (k=1;k<=NN_OUT;k++){
+			target[k]=targets[p*NN_OUT+k-1];
+		}
+		NN_FN(Forward)(inputs, InWeights, hidden, HidWeights, outputs);
+		for (k=1;k<=NN_OUT;k++){
+			e=target[k]-outputs[k];
+			error+=0.5f*e*e;
+		}
+		NN_FN(AccumulateGradients)(target, inputs, hidden, HidWeights, outputs, InGrad, HidGrad);
+		if ((++n>=batchSize) || (m==numPat-1)){
+			NN_FN(ApplyGradientsOpt)(InWeights, HidWeights, InGrad, HidGrad, opt);
+			n=0;
+		}
+	}
+	return error;
+}
+
+/*******************************************************/
+/*  Fixed point Forward and Back Propagation           */
+/*  Same algorithm in Q15, see supervisedNNFixed.h.     */
+/*******************************************************/
+
+NN_STORAGE void NN_FN(ForwardQ15)(long inputs[NN_IN+1], long InWeights[][NN_HID+1], long hidden[NN_HID+1], long HidWeights[][NN_OUT+1], long outputs[NN_OUT+1]){
+	int i,j,k;
+	long long sum;
+
+	for (j=1;j<=NN_HID;j++){
+		sum=0;
+		for (i=0;i<=NN_IN;i++) {
+			sum+=(long long)inputs[i]*InWeights[i][j];
+		}
+		hidden[j]= sigmoidQ15(Q15Sat((sum+(1<<14))>>15));
+	}
+
+	for (k=1;k<=NN_OUT;k++){
+		sum=0;
+		for (j=0;j<=NN_HID;j++){
+			sum+=(long long)hidden[j]*HidWeights[j][k];
+		}
+		outputs[k]= sigmoidQ15(Q15Sat((sum+(1<<14))>>15));
+	}
+}
+
+NN_STORAGE void NN_FN(BackPropagationQ15)(long target[NN_OUT+1], long inputs[NN_IN+1], long InWeights[][NN_HID+1], long hidden[NN_HID+1], long HidWeights[][NN_OUT+1], long outputs[NN_OUT+1], long eta){
+	int i,j,k;
+	long DeltaOH[NN_OUT+1];
+	long long sum;
+	long d;
+
+	for (k=1;k<=NN_OUT;k++){
+		DeltaOH[k] = Q15Add(target[k],-outputs[k]);
+		d=Q15Mul(eta,DeltaOH[k]);
+		for (j=0;j<=NN_HID;j++){
+			HidWeights[j][k] = Q15Add(HidWeights[j][k],Q15Mul(d,hidden[j]));
+		}
+	}
+
+	for (j=1;j<=NN_HID;j++){
+		sum=0;
+		for (k=1;k<=NN_OUT;k++){
+			sum+=(long long)HidWeights[j][k]*DeltaOH[k];
+		}
+		d=Q15Sat((sum+(1<<14))>>15);
+		d=Q15Mul(d,Q15Mul(hidden[j],Q15_ONE-hidden[j]));
+		d=Q15Mul(eta,d);
+		for (i=0;i<=NN_IN;i++) {
+			InWeights[i][j] = Q15Add(InWeights[i][j],Q15Mul(d,inputs[i]));
+		}
+	}
+}
+
+/* Q15 gradient sums, as AccumulateGradients */
+NN_STORAGE void NN_FN(AccumulateGradientsQ15)(long target[NN_OUT+1], long inputs[NN_IN+1], long hidden[NN_HID+1], long HidWeights[][NN_OUT+1], long outputs[NN_OUT+1], long InGrad[][NN_HID+1], long HidGrad[][NN_OUT+1]){
+	int i,j,k;
+	long DeltaOH[NN_OUT+1];
+	long long sum;
+	long d;
+
+	for (k=1;k<=NN_OUT;k++){
+		DeltaOH[k] = Q15Add(target[k],-outputs[k]);
+		for (j=0;j<=NN_HID;j++){
+			HidGrad[j][k] = Q15Add(HidGrad[j][k],Q15Mul(DeltaOH[k],hidden[j]));
+		}
+	}
+
+	for (j=1;j<=NN_HID;j++){
+		sum=0;
+		for (k=1;k<=NN_OUT;k++){
+			sum+=(long long)HidWeights[j][k]*DeltaOH[k];
+		}
+		d=Q15Sat((sum+(1<<14))>>15);
+		d=Q15Mul(d,Q15Mul(hidden[j],Q15_ONE-hidden[j]));
+		for (i=0;i<=NN_IN;i++) {
+			InGrad[i][j] = Q15Add(InGrad[i][j],Q15Mul(d,inputs[i]));
+		}
+	}
+}
+
+/* Q15 update of opt, set up with OptimizerInit(..., 1) and OptimizerWeights */
+NN_STORAGE void NN_FN(ApplyGradientsOptQ15)(long InWeights[][NN_HID+1], long HidWeights[][NN_OUT+1], long InGrad[][NN_HID+1], long HidGrad[][NN_OUT+1], tOptimizer *opt){
+	OptimizerBegin(opt);
+	OptimizerApplyQ15(opt, 0, &InWeights[0][0], &InGrad[0][0]);
+	OptimizerApplyQ15(opt, 1, &HidWeights[0][0], &HidGrad[0][0]);
+}
+
+/* Q15 TrainEpochOpt, returns the epoch error in Q15.  OPT_SGD */
+/* with batchSize<=1 is BackPropagationQ15                      */
+NN_STORAGE long NN_FN(TrainEpochOptQ15)(long patterns[][NN_IN], long targets[], const unsigned short order[], int numPat, int batchSize, long inBias, long hidBias, long InWeights[][NN_HID+1], long HidWeights[][NN_OUT+1], long InGrad[][NN_HID+1], long HidGrad[][NN_OUT+1], tOptimizer *opt){
+	long inputs[NN_IN+1];
+	long hidden[NN_HID+1];
+	long outputs[NN_OUT+1];
+	long target[NN_OUT+1];
+	long error=0;
+	long e;
+	int i,k,m,p;
+	int n=0;
+
+	inputs[0]=inBias;
+	hidden[0]=hidBias;
+	for (m=0;m<numPat;m++){
+		p = order ? order[m] : m;
+		for (i=1;i<=NN_IN;i++){
+			inputs[i]=patterns[p][i-1];
+		}
+		for (k=1;k<=NN_OUT;k++){
+			target[k]=targets[p*NN_OUT+k-1];
+		}
+		NN_FN(ForwardQ15)(inputs, InWeights, hidden, HidWeights, outputs);
+		for (k=1;k<=NN_OUT;k++){
+			e=Q15Add(target[k],-outputs[k]);
+			error=Q15Add(error,Q15Mul(e,e)/2);
+		}
+		if ((batchSize<=1) && (opt->Method==OPT_SGD)){
+			NN_FN(BackPropagationQ15)(target, inputs, InWeights, hidden, HidWeights, outputs, opt->EtaQ);
+			continue;
+		}
+		NN_FN(AccumulateGradientsQ15)(target, inputs, hidden, HidWeights, outputs, InGrad, HidGrad);
+		if ((++n>=batchSize) || (m==numPat-1)){
+			NN_FN(ApplyGradientsOptQ15)(InWeights, HidWeights, InGrad, HidGrad, opt);
+			n=0;
+		}
+	}
+	return error;
+}
+
+/*******************************************************/
+/*  Weights Initialization                             */
+/*******************************************************/
+
+NN_STORAGE void NN_FN(InWeightsInit)(float InWeights[][NN_HID+1]){
+	PRNGFill(&NNRandom, &InWeights[0][0], (NN_IN+1)*(NN_HID+1), -1.0, 1.0);
+}
+
+NN_STORAGE void NN_FN(HidWeightsInit)(float HidWeights[][NN_OUT+1]){
+	PRNGFill(&NNRandom, &HidWeights[0][0], (NN_HID+1)*(NN_OUT+1), -1.0, 1.0);
+}
+
+/* One of the WeightsInit() strategies per layer.  Column 0 is not used and */
+/* is left as it is                                                         */
+NN_STORAGE void NN_FN(InWeightsInitMode)(float InWeights[][NN_HID+1], int mode){
+	WeightsInit(&InWeights[0][1], NN_IN, NN_HID, NN_HID+1, 1, mode);
+}
+
+NN_STORAGE void NN_FN(HidWeightsInitMode)(float HidWeights[][NN_OUT+1], int mode){
+	WeightsInit(&HidWeights[0][1], NN_HID, NN_OUT, NN_OUT+1, 1, mode);
+}
+
+/*******************************************************/
+/*  Network type helpers                               */
+/*******************************************************/
+
+NN_STORAGE void NN_FN(NetInit)(NN_FN(Net) *net, float bias){
+	NN_FN(InWeightsInit)(net->InWeights);
+	NN_FN(HidWeightsInit)(net->HidWeights);
+	net->Inputs[0]=bias;
+	net->Hidden[0]=bias;
+}
+
+NN_STORAGE void NN_FN(NetForward)(NN_FN(Net) *net){
+	NN_FN(Forward)(net->Inputs, net->InWeights, net->Hidden, net->HidWeights, net->Outputs);
+}
+
+NN_STORAGE void NN_FN(NetBackPropagation)(NN_FN(Net) *net, float target[NN_OUT+1], float eta){
+	NN_FN(BackPropagation)(target, net->Inputs, net->InWeights, net->Hidden, net->HidWeights, net->Outputs, eta);
+}
+
+#undef NN_NAME
+#undef NN_IN
+#undef NN_HID
+#undef NN_OUT
+#undef NN_STORAGE
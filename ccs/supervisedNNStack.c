@@ -0,0 +1,183 @@
+/*****************************************************************************************/
+/* Multilayer Neural Network with Backpropagation                                        */
+/*                                                                                       */
+/* Generic forward and backward pass over the layer stack described in                   */
+/* supervisedNNStack.h.  The update rule is the one of BackPropagation(): the output     */
+/* error is (target-output), the weights of a layer are updated before its error is      */
+/* propagated down, and hidden errors are scaled by the sigmoid derivative.  A stack     */
+/* of {NumIn, NumHid, NumOut} therefore trains exactly like the fixed 3 layer network.   */
+/*****************************************************************************************/
+
+#include "supervisedNNStack.h"
+#include "supervisedNN.h"
+
+/*******************************************************/
+/*  Arena size for a topology                          */
+/*******************************************************/
+
+unsigned long NNStackArenaSize(const short *sizes, short numLayers){
+	unsigned long floats;
+	short l;
+
+	floats = sizes[0]+1;		/* input activations */
+	for (l=1;l<numLayers;l++){
+		floats += NN_STACK_LAYER_FLOATS(sizes[l-1], sizes[l]);
+	}
+	return floats;
+}
+
+/*******************************************************/
+/*  Lay out the network in the arena                   */
+/*  Returns 0 on success, -1 if the topology is not     */
+/*  valid or the arena is too small.                   */
+/*******************************************************/
+
+int NNStackInit(tNNStack *net, const short *sizes, short numLayers, float bias, float *arena, unsigned long arenaSize){
+	float *next;
+	short l;
+
+	if ((numLayers<2) || (numLayers>NN_STACK_MAX_LAYERS) || (NNStackArenaSize(sizes, numLayers)>arenaSize)){
+		return -1;
+	}
+
+	net->LayerCount = numLayers;
+	net->NumWeights = 0;
+	for (l=0;l<numLayers;l++){
+		net->Size[l] = sizes[l];
+	}
+
+	/**** weights first so that they form one block ******/
+	net->WeightArena = arena;
+	next = arena;
+	for (l=0;l<numLayers-1;l++){
+		net->Weights[l] = next;
+		next += (sizes[l]+1)*sizes[l+1];
+	}
+	net->Weights[numLayers-1] = 0;
+	net->NumWeights = next-arena;
+
+	for (l=0;l<numLayers;l++){
+		net->Act[l] = next;
+		next += sizes[l]+1;
+		net->Act[l][0] = bias;
+	}
+
+	net->Delta[0] = 0;
+	for (l=1;l<numLayers;l++){
+		net->Delta[l] = next-1;		/* Delta[l][1..Size[l]] like the activations */
+		next += sizes[l];
+	}
+	return 0;
+}
+
+/*******************************************************/
+/*  Weights Initialization                             */
+/*******************************************************/
+
+void NNStackWeightsInit(tNNStack *net){
+	PRNGFill(&NNRandom, net->WeightArena, net->NumWeights, -1.0, 1.0);
+}
+
+/* modes[l] is the WeightsInit() strategy of the weights from layer l to l+1 */
+void NNStackWeightsInitMode(tNNStack *net, const unsigned char *modes){
+	short l;
+
+	for (l=0;l<net->LayerCount-1;l++){
+		WeightsInit(net->Weights[l], net->Size[l], net->Size[l+1], 1, net->Size[l]+1, modes[l]);
+	}
+}
+
+/*******************************************************/
+/***********  Forward Algorithm                        */
+/*  inputs has Size[0] values (no bias).  Returns the   */
+/*  Size[LayerCount-1] outputs.                         */
+/*******************************************************/
+
+float *NNStackForward(tNNStack *net, const float *inputs){
+	short i,j,l;
+	short nIn, nOut;
+	const float *in;
+	const float *w;
+	float *out;
+	float sum;
+
+	for (i=0;i<net->Size[0];i++){
+		net->Act[0][i+1]=inputs[i];
+	}
+
+	for (l=0;l<net->LayerCount-1;l++){
+		nIn = net->Size[l]+1;
+		nOut = net->Size[l+1];
+		in = net->Act[l];
+		out = net->Act[l+1];
+		w = net->Weights[l];
+		for (j=1;j<=nOut;j++){
+			sum=0;
+			for (i=0;i<nIn;i++){
+				sum+=in[i]*w[i];
+			}
+			out[j]=NN_SIGMOID(sum);
+			w+=nIn;
+		}
+	}
+	return &net->Act[net->LayerCount-1][1];
+}
+
+/*******************************************************/
+/*  Back Propagation Algorithm                         */
+/*  Must follow NNStackForward() on the same pattern.  */
+/*  target has Size[LayerCount-1] values.  Returns the   */
+/*  pattern error 0.5*sum((target-output)^2).          */
+/*******************************************************/
+
+float NNStackBackPropagation(tNNStack *net, const float *target, float eta){
+	short i,j,l;
+	short nIn, nOut;
+	short top = net->LayerCount-1;
+	float *in;
+	float *w;
+	float *delta;
+	float *deltaIn;
+	float error=0;
+	float d;
+
+	/**** output error ******/
+	delta = net->Delta[top];
+	for (j=1;j<=net->Size[top];j++){
+		delta[j]=target[j-1]-net->Act[top][j];
+		error+=0.5f*delta[j]*delta[j];
+	}
+
+	for (l=top-1;l>=0;l--){
+		nIn = net->Size[l]+1;
+		nOut = net->Size[l+1];
+		in = net->Act[l];
+		delta = net->Delta[l+1];
+
+		/**** update the weights feeding layer l+1 ******/
+		w = net->Weights[l];
+		for (j=1;j<=nOut;j++){
+			d=eta*delta[j];
+			for (i=0;i<nIn;i++){
+				w[i]+=d*in[i];
+			}
+			w+=nIn;
+		}
+
+		/**** backpropagate the error to layer l ******/
+		if (l==0){
+			break;
+		}
+		deltaIn = net->Delta[l];
+		for (i=1;i<nIn;i++){
+			d=0;
+			w = net->Weights[l]+i;
+			for (j=1;j<=nOut;j++){
+				d+=(*w)*delta[j];
+				w+=nIn;
+			}
+			deltaIn[i]=d*in[i]*(1-in[i]);
+		}
+	}
+	return error;
+}
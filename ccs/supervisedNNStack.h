@@ -0,0 +1,43 @@
+#ifndef SUPERVISEDNNSTACK_H_
+#define SUPERVISEDNNSTACK_H_
+
+/*****************************************************************************************/
+/* Multilayer Neural Network with an arbitrary number of hidden layers                   */
+/*                                                                                       */
+/* The topology is given at run time as a list of layer sizes (input, hidden..., output, */
+/* bias not included).  All the activations, deltas and weights live in one float arena  */
+/* supplied by the caller, with the weights of every layer stored back to back, so no    */
+/* heap is needed and a new model only needs a bigger arena.                             */
+/*****************************************************************************************/
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#define NN_STACK_MAX_LAYERS 8
+
+/* Number of floats of arena needed by a topology, usable for static arrays */
+#define NN_STACK_LAYER_FLOATS(from, to) (((from)+1)*(to) + (to)+1 + (to))
+
+typedef struct {
+	short LayerCount;						/* input + hidden + output layers			*/
+	short Size[NN_STACK_MAX_LAYERS];		/* neurons per layer, bias not included		*/
+	float *Act[NN_STACK_MAX_LAYERS];		/* activations, Act[l][0] is the bias		*/
+	float *Delta[NN_STACK_MAX_LAYERS];		/* error terms of layers 1..LayerCount-1		*/
+	float *Weights[NN_STACK_MAX_LAYERS];	/* Weights[l][j*(Size[l]+1)+i]: from neuron	*/
+											/* i of layer l to neuron j+1 of layer l+1	*/
+	float *WeightArena;						/* all the weights, contiguous				*/
+	unsigned long NumWeights;
+} tNNStack;
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern unsigned long NNStackArenaSize(const short *sizes, short numLayers);
+extern int NNStackInit(tNNStack *net, const short *sizes, short numLayers, float bias, float *arena, unsigned long arenaSize);
+extern void NNStackWeightsInit(tNNStack *net);
+extern void NNStackWeightsInitMode(tNNStack *net, const unsigned char *modes);
+extern float *NNStackForward(tNNStack *net, const float *inputs);
+extern float NNStackBackPropagation(tNNStack *net, const float *target, float eta);
+
+#endif /*SUPERVISEDNNSTACK_H_*/
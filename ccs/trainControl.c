@@ -0,0 +1,75 @@
+/*****************************************************************************************/
+/* Training controller                                                                   */
+/*                                                                                       */
+/* Stop conditions and epoch timing of trainControl.h.                                   */
+/*****************************************************************************************/
+
+#include "trainControl.h"
+
+#define TRAIN_MIN_DELTA 0.001f		/* default: 0.1% better than the best error */
+
+/* Short names, they fit in the title row of the OLED */
+static const char *ReasonNames[STOP_REASONS] = {
+	"Training", "Done", "Epochs", "Stalled", "Budget"
+};
+
+void TrainControlInit(tTrainControl *ctl, unsigned long maxEpochs, float errorThreshold, unsigned long patience, unsigned long cycleBudget){
+	ctl->MaxEpochs = maxEpochs;
+	ctl->ErrorThreshold = errorThreshold;
+	ctl->Patience = patience;
+	ctl->MinDelta = TRAIN_MIN_DELTA;
+	ctl->CycleBudget = cycleBudget;
+	TrainControlStart(ctl);
+}
+
+/* Clear the counters, before a new training */
+void TrainControlStart(tTrainControl *ctl){
+	ctl->Reason = STOP_NONE;
+	ctl->Epochs = 0;
+	ctl->BestError = 0;
+	ctl->BestEpoch = 0;
+	ctl->Cycles = 0;
+	ctl->LastCycles = 0;
+	ctl->MaxCycles = 0;
+}
+
+/*******************************************************/
+/*  After an epoch of error error that took cycles     */
+/*  cycles: STOP_NONE to go on, or the reason to stop, */
+/*  also left in Reason.                               */
+/*******************************************************/
+
+int TrainControlEpoch(tTrainControl *ctl, float error, unsigned long cycles){
+	ctl->Epochs++;
+	ctl->LastCycles = cycles;
+	if (cycles > ctl->MaxCycles){
+		ctl->MaxCycles = cycles;
+	}
+	ctl->Cycles = (ctl->Cycles + cycles < ctl->Cycles) ? 0xFFFFFFFFUL : ctl->Cycles + cycles;
+	if ((ctl->Epochs == 1) || (error < ctl->BestError*(1-ctl->MinDelta))){
+		ctl->BestError = error;
+		ctl->BestEpoch = ctl->Epochs;
+	}
+
+	if (error <= ctl->ErrorThreshold){
+		ctl->Reason = STOP_CONVERGED;
+	}
+	else if (ctl->MaxEpochs && (ctl->Epochs >= ctl->MaxEpochs)){
+		ctl->Reason = STOP_EPOCHS;
+	}
+	else if (ctl->Patience && (ctl->Epochs - ctl->BestEpoch >= ctl->Patience)){
+		ctl->Reason = STOP_PATIENCE;
+	}
+	else if (ctl->CycleBudget && (ctl->Cycles >= ctl->CycleBudget)){
+		ctl->Reason = STOP_BUDGET;
+	}
+	return ctl->Reason;
+}
+
+unsigned long TrainControlCyclesPerEpoch(const tTrainControl *ctl){
+	return ctl->Epochs ? ctl->Cycles/ctl->Epochs : 0;
+}
+
+const char *TrainControlReason(int reason){
+	return (reason >= 0 && reason < STOP_REASONS) ? ReasonNames[reason] : "?";
+}
@@ -0,0 +1,55 @@
+#ifndef TRAINCONTROL_H_
+#define TRAINCONTROL_H_
+
+/*****************************************************************************************/
+/* Training controller                                                                   */
+/*                                                                                       */
+/* Decides after every epoch whether a training goes on, and why it stops:               */
+/*                                                                                       */
+/*   STOP_CONVERGED  the epoch error is at or below ErrorThreshold                       */
+/*   STOP_EPOCHS     MaxEpochs epochs were trained                                       */
+/*   STOP_PATIENCE   the best error has not dropped by MinDelta (relative) for Patience  */
+/*                   epochs: the run is stuck on a plateau or in a local minimum         */
+/*   STOP_BUDGET     the epochs have used CycleBudget cycles                             */
+/*                                                                                       */
+/* Patience, MaxEpochs and CycleBudget are off when 0.  The caller times each epoch and  */
+/* passes its cycles to TrainControlEpoch(), which keeps the total, the last and the     */
+/* worst epoch for TrainControlCyclesPerEpoch() and the reports.                         */
+/*****************************************************************************************/
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#define STOP_NONE 0						/* training goes on */
+#define STOP_CONVERGED 1
+#define STOP_EPOCHS 2
+#define STOP_PATIENCE 3
+#define STOP_BUDGET 4
+#define STOP_REASONS 5
+
+typedef struct {
+	unsigned long MaxEpochs;			/* limits, 0 is no limit					*/
+	float ErrorThreshold;
+	unsigned long Patience;
+	float MinDelta;						/* relative drop that counts as progress	*/
+	unsigned long CycleBudget;
+	unsigned char Reason;				/* STOP_NONE while the training runs		*/
+	unsigned long Epochs;				/* epochs since TrainControlStart()			*/
+	float BestError;
+	unsigned long BestEpoch;
+	unsigned long Cycles;				/* of all the epochs, saturated				*/
+	unsigned long LastCycles;
+	unsigned long MaxCycles;
+} tTrainControl;
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern void TrainControlInit(tTrainControl *ctl, unsigned long maxEpochs, float errorThreshold, unsigned long patience, unsigned long cycleBudget);
+extern void TrainControlStart(tTrainControl *ctl);
+extern int TrainControlEpoch(tTrainControl *ctl, float error, unsigned long cycles);
+extern unsigned long TrainControlCyclesPerEpoch(const tTrainControl *ctl);
+extern const char *TrainControlReason(int reason);
+
+#endif /*TRAINCONTROL_H_*/
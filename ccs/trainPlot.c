@@ -0,0 +1,72 @@
+/*****************************************************************************************/
+/* Live training error curve                                                             */
+/*                                                                                       */
+/* Column decimation and rendering over the plot functions of the OLED driver, see       */
+/* trainPlot.h.                                                                          */
+/*****************************************************************************************/
+
+#include "inc/hw_types.h"
+#include "Drivers/rit128x96x4.h"
+#include "trainPlot.h"
+
+#define TRAIN_PLOT_SCALE 1000			/* plot units per 1.0 of error */
+
+/*******************************************************/
+/*  Empty plot, one epoch per column.  Also clears the  */
+/*  plot image and draws the axis labels, in hundredths */
+/*  of error, into the off-screen frame.                */
+/*******************************************************/
+
+void TrainPlotInit(tTrainPlot *plot){
+	plot->Columns = 0;
+	plot->EpochsPerColumn = 1;
+	plot->Epochs = 0;
+	plot->Sum = 0;
+	RIT128x96x4PlotClear(0, (long)(TRAIN_PLOT_MAX_ERROR*TRAIN_PLOT_SCALE),
+		0, (long)(TRAIN_PLOT_MAX_ERROR*100/3), (long)(TRAIN_PLOT_MAX_ERROR*100*2/3),
+		(long)(TRAIN_PLOT_MAX_ERROR*100));
+}
+
+/*******************************************************/
+/*  Account the error of one more epoch                 */
+/*******************************************************/
+
+void TrainPlotAdd(tTrainPlot *plot, float error){
+	unsigned short i;
+
+	plot->Sum += error;
+	if (++plot->Epochs < plot->EpochsPerColumn){
+		return;
+	}
+
+	/**** plot full: halve the resolution, the open column becomes  ******/
+	/**** the first half of the next wider one                       ******/
+	if (plot->Columns == TRAIN_PLOT_COLUMNS){
+		for (i=0;i<TRAIN_PLOT_COLUMNS/2;i++){
+			plot->Column[i] = 0.5f*(plot->Column[2*i]+plot->Column[2*i+1]);
+		}
+		plot->Columns = TRAIN_PLOT_COLUMNS/2;
+		plot->EpochsPerColumn *= 2;
+		return;
+	}
+
+	plot->Column[plot->Columns++] = plot->Sum/plot->Epochs;
+	plot->Epochs = 0;
+	plot->Sum = 0;
+}
+
+/*******************************************************/
+/*  Render the complete columns into the off-screen     */
+/*  frame; RIT128x96x4Flush() sends the changed bytes.  */
+/*******************************************************/
+
+void TrainPlotDraw(const tTrainPlot *plot){
+	unsigned short i;
+
+	RIT128x96x4PlotReClear();
+	for (i=0;i<plot->Columns;i++){
+		RIT128x96x4PlotPoint((long)(plot->Column[i]*TRAIN_PLOT_SCALE));
+		RIT128x96x4PlotNext();
+	}
+	RIT128x96x4ShowPlot();
+}
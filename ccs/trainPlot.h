@@ -0,0 +1,37 @@
+#ifndef TRAINPLOT_H_
+#define TRAINPLOT_H_
+
+/*****************************************************************************************/
+/* Live training error curve                                                             */
+/*                                                                                       */
+/* Decimates the epoch errors of a training run into the TRAIN_PLOT_COLUMNS columns of   */
+/* the OLED driver plot (PlotImage).  Each column holds the mean error of                */
+/* EpochsPerColumn consecutive epochs.  When the plot is full, neighbouring columns are  */
+/* averaged in pairs and EpochsPerColumn doubles, so a run of any length always fits on  */
+/* the screen and the cost per epoch stays one addition.  TrainPlotDraw() renders the    */
+/* columns into the off-screen frame; how often it is called is left to the caller.      */
+/*****************************************************************************************/
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#define TRAIN_PLOT_COLUMNS 108			/* data columns of the driver plot, even */
+#define TRAIN_PLOT_MAX_ERROR 0.6		/* error at the top of the plot */
+
+typedef struct {
+	float Column[TRAIN_PLOT_COLUMNS];	/* mean error of each complete column		*/
+	unsigned short Columns;				/* complete columns							*/
+	unsigned long EpochsPerColumn;
+	unsigned long Epochs;				/* epochs summed in the open column			*/
+	float Sum;
+} tTrainPlot;
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern void TrainPlotInit(tTrainPlot *plot);
+extern void TrainPlotAdd(tTrainPlot *plot, float error);
+extern void TrainPlotDraw(const tTrainPlot *plot);
+
+#endif /*TRAINPLOT_H_*/
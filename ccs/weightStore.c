@@ -0,0 +1,127 @@
+/*****************************************************************************************/
+/* Flash weight store                                                                    */
+/*                                                                                       */
+/* Record lookup, restore and save of the two block store described in weightStore.h.   */
+/*****************************************************************************************/
+
+#include <string.h>
+#include "inc/hw_types.h"
+#include "driverlib/flash.h"
+#include "weightStore.h"
+#include "crc32.h"
+
+#define WSTORE_RECORD(block) ((const tWeightRecord *)(unsigned long)(WSTORE_BASE + (block)*WSTORE_BLOCK_SIZE))
+#define WSTORE_CRC_BYTES (sizeof(tWeightRecord) - sizeof(unsigned int))
+
+/*******************************************************/
+/*  Record of a block, or 0 if it is erased, torn or   */
+/*  from another build.                                */
+/*******************************************************/
+
+static const tWeightRecord *WeightStoreCheck(int block){
+	const tWeightRecord *record = WSTORE_RECORD(block);
+
+	if ((record->Magic != WSTORE_MAGIC) || (record->Version != WSTORE_VERSION) ||
+		(record->Size != sizeof(tWeightRecord)) ||
+		(record->In != NumIn) || (record->Hid != NumHid) || (record->Out != NumOut)){
+		return 0;
+	}
+	if (record->Crc != (unsigned int)Crc32(CRC32_INIT, record, WSTORE_CRC_BYTES)){
+		return 0;
+	}
+	return record;
+}
+
+/*******************************************************/
+/*  Newest valid record, read in place, or 0           */
+/*******************************************************/
+
+const tWeightRecord *WeightStoreFind(void){
+	const tWeightRecord *newest = 0;
+	const tWeightRecord *record;
+	int block;
+
+	for (block=0;block<WSTORE_BLOCKS;block++){
+		record = WeightStoreCheck(block);
+		/* Sequence wraps after 2^32 saves, compare the difference */
+		if (record && (!newest || ((int)(record->Sequence - newest->Sequence) > 0))){
+			newest = record;
+		}
+	}
+	return newest;
+}
+
+/*******************************************************/
+/*  Copy the newest record into the weights.           */
+/*  Returns 0, or -1 if there is none (the weights     */
+/*  are left as they are).                             */
+/*******************************************************/
+
+int WeightStoreLoad(float InWeights[][NumHid+1], float HidWeights[][NumOut+1]){
+	const tWeightRecord *record = WeightStoreFind();
+
+	if (!record){
+		return -1;
+	}
+	memcpy(InWeights, record->InWeights, sizeof(record->InWeights));
+	memcpy(HidWeights, record->HidWeights, sizeof(record->HidWeights));
+	return 0;
+}
+
+/*******************************************************/
+/*  Program the weights into the block that does not   */
+/*  hold the newest record.  FlashUsecSet() must have  */
+/*  been called.  The CPU stalls on flash fetches      */
+/*  during the erase, so do not save while sampling    */
+/*  (NN_XOR.c holds the save back while streaming).    */
+/*  Returns 0, or -1 if the flash could not be         */
+/*  written or does not read back right.               */
+/*******************************************************/
+
+int WeightStoreSave(float InWeights[][NumHid+1], float HidWeights[][NumOut+1], unsigned long epochs, float error){
+	static tWeightRecord record;		/* off the 256 byte stack */
+	const tWeightRecord *newest = WeightStoreFind();
+	int block = 0;
+
+	if (newest == WSTORE_RECORD(0)){
+		block = 1;
+	}
+
+	memset(&record, 0, sizeof(record));
+	record.Magic = WSTORE_MAGIC;
+	record.Version = WSTORE_VERSION;
+	record.Size = sizeof(tWeightRecord);
+	record.Sequence = newest ? newest->Sequence+1 : 1;
+	record.In = NumIn;
+	record.Hid = NumHid;
+	record.Out = NumOut;
+	record.Epochs = (unsigned int)epochs;
+	record.Error = error;
+	memcpy(record.InWeights, InWeights, sizeof(record.InWeights));
+	memcpy(record.HidWeights, HidWeights, sizeof(record.HidWeights));
+	record.Crc = (unsigned int)Crc32(CRC32_INIT, &record, WSTORE_CRC_BYTES);
+
+	if (FlashErase(WSTORE_BASE + block*WSTORE_BLOCK_SIZE) != 0){
+		return -1;
+	}
+	if (FlashProgram((unsigned long *)&record, WSTORE_BASE + block*WSTORE_BLOCK_SIZE, sizeof(record)) != 0){
+		return -1;
+	}
+	return (WeightStoreCheck(block) ? 0 : -1);
+}
+
+/*******************************************************/
+/*  Forget the stored weights, the next reset trains   */
+/*  from random weights again.  Returns 0 or -1.       */
+/*******************************************************/
+
+int WeightStoreErase(void){
+	int block;
+
+	for (block=0;block<WSTORE_BLOCKS;block++){
+		if (FlashErase(WSTORE_BASE + block*WSTORE_BLOCK_SIZE) != 0){
+			return -1;
+		}
+	}
+	return 0;
+}
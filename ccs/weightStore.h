@@ -0,0 +1,55 @@
+#ifndef WEIGHTSTORE_H_
+#define WEIGHTSTORE_H_
+
+/*****************************************************************************************/
+/* Flash weight store                                                                    */
+/*                                                                                       */
+/* Keeps the last trained weights of the network in the WSTORE region that               */
+/* lm3s1968.cmd reserves at the top of the flash, so a reset can run the network at once */
+/* instead of training again.  The region holds two 1 KB erase blocks, used in turn: a   */
+/* save erases and programs the block that does not hold the newest record, so a reset   */
+/* or a power loss in the middle of a save leaves the previous record intact.            */
+/*                                                                                       */
+/* A record is valid when its magic, version, size and topology match this build and   */
+/* its CRC-32 (crc32.h) is right; the newest valid one has the highest Sequence.  The    */
+/* records are read in place through the memory map, finding and checking one costs a   */
+/* few hundred cycles.  All the fields are 32 bits or less on the target and the host,   */
+/* so a host image of the region has the layout of the board.                            */
+/*****************************************************************************************/
+
+#include "supervisedNN.h"
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#ifndef WSTORE_BASE
+#define WSTORE_BASE 0x0003F800		/* WSTORE region of lm3s1968.cmd */
+#endif
+#define WSTORE_BLOCK_SIZE 0x400		/* flash erase block */
+#define WSTORE_BLOCKS 2
+#define WSTORE_MAGIC 0x5754534E		/* "NSTW" */
+#define WSTORE_VERSION 1			/* layout of tWeightRecord */
+
+typedef struct {
+	unsigned int Magic;						/* WSTORE_MAGIC								*/
+	unsigned short Version;					/* WSTORE_VERSION							*/
+	unsigned short Size;					/* bytes of the record, Crc included		*/
+	unsigned int Sequence;					/* one more than the previous save			*/
+	unsigned char In, Hid, Out, Reserved;	/* topology, bias not included				*/
+	unsigned int Epochs;					/* training epochs of these weights			*/
+	float Error;							/* epoch error at the end of the training	*/
+	float InWeights[NumIn+1][NumHid+1];
+	float HidWeights[NumHid+1][NumOut+1];
+	unsigned int Crc;						/* CRC-32 of everything above				*/
+} tWeightRecord;
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern const tWeightRecord *WeightStoreFind(void);
+extern int WeightStoreLoad(float InWeights[][NumHid+1], float HidWeights[][NumOut+1]);
+extern int WeightStoreSave(float InWeights[][NumHid+1], float HidWeights[][NumOut+1], unsigned long epochs, float error);
+extern int WeightStoreErase(void);
+
+#endif /*WEIGHTSTORE_H_*/
@@ -0,0 +1,271 @@
+/*****************************************************************************************/
+/* Host simulator for the NN_XOR firmware                                                */
+/*                                                                                       */
+/* Runs the unmodified firmware main() against the driverlib stand-ins in hostsim.c and  */
+/* replays a script of button presses given on the command line, e.g.                    */
+/*                                                                                       */
+/*     NN_XOR_sim -s 4 up down show                                                      */
+/*     NN_XOR_sim -s 4 up down adc=1023,0 wait=500 show                                  */
+/*                                                                                       */
+/* "wait=<ms>" lets the firmware run on its own (SysTick, ADC, streaming inference) for  */
+/* that long before the next event.                                                      */
+/* -s sets NNSeed, the seed of the initial weights, -i their initialization strategy,    */
+/* -m the optimizer (optimizer.h), -l the eta schedule (schedule.h) and -o the pattern   */
+/* order.  Without -s the firmware seeds the weights from the ADC noise as on the        */
+/* target, which is always the same value here.                                          */
+/* -f keeps the flash weight store in a file: it is loaded before the firmware starts    */
+/* and saved at the end, so a second run restores the weights trained by the first.      */
+/* Each event is delivered when the firmware goes idle and its OLED transfers are out.   */
+/* The time spent in the handler, the time until then and the OLED traffic are reported  */
+/* on stderr, followed by the weights seed, the worst case handler times, the OLED queue */
+/* statistics, why the training stopped (trainControl.h) with its time per epoch and the */
+/* profiling scopes (profile.h) at the end.  The screen is printed on stdout for every   */
+/* "show" and once more when the script is finished.                                     */
+/*****************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "inc/hw_types.h"
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+#include "hostsim.h"
+#include "Drivers/rit128x96x4.h"
+#include "profile.h"
+#include "trainControl.h"
+
+extern int NNXORMain(void);
+extern volatile unsigned long ADCIntCyclesMax;
+extern volatile unsigned long GPIOIntCyclesMax;
+extern volatile unsigned long SysTickIntCyclesMax;
+extern volatile unsigned long StreamInferences;
+extern volatile unsigned long StreamLatencyMax;
+extern volatile unsigned long SysTickCount;
+extern volatile unsigned long StreamStartTick;
+extern volatile unsigned long OLEDTransfers;
+extern volatile unsigned long TrainingCycles;
+extern volatile unsigned long PlotCycles;
+extern volatile unsigned long PlotFrames;
+extern float eta;
+extern float TrainingError;
+extern volatile unsigned long NNSeed;
+extern short PatternMode;
+extern short OptimizerMethod;
+extern short ScheduleMode;
+extern short InWeightsMode;
+extern short HidWeightsMode;
+extern short WeightsRestored;
+extern volatile unsigned long RestoreCycles;
+extern tTrainControl TrainingControl;
+
+/*******************************************************/
+/*  Script events                                      */
+/*******************************************************/
+
+static const struct
+{
+	const char *pcName;
+	unsigned char ucPins;
+}
+g_psButtons[] =
+{
+	{ "up",     GPIO_PIN_3 },
+	{ "down",   GPIO_PIN_4 },
+	{ "left",   GPIO_PIN_5 },
+	{ "right",  GPIO_PIN_6 },
+	{ "select", GPIO_PIN_7 },
+};
+
+static char **g_ppcScript;
+static int g_iScriptLen;
+static int g_iScriptPos;
+static const char *g_pcPGM;
+static const char *g_pcFlash;
+static int g_iQuiet;
+
+static const char *g_pcPending;
+static double g_dPendingStart;
+static double g_dPendingISR;
+static double g_dWaitUntil;
+
+static void Usage(const char *pcProg)
+{
+	fprintf(stderr,
+		"usage: %s [-s seed] [-e eta] [-m optimizer] [-l schedule] [-o order] [-i init,init]\n"
+		"       [-f flash.bin] [-p screen.pgm] [-q] event...\n"
+		"optimizer: 0 sgd, 1 momentum, 2 nesterov, 3 rmsprop, 4 adam\n"
+		"schedule: 0 constant, 1 step, 2 exponential, 3 bold driver\n"
+		"order: 0 fixed, 1 shuffled every epoch, 2 sampled with replacement\n"
+		"init: input and hidden layer, 0 uniform, 1 xavier, 2 xavier normal, 3 he,\n"
+		"      4 he normal, 5 orthogonal\n"
+		"events: up down left right select show adc=<ch0>,<ch1> wait=<ms>\n", pcProg);
+	exit(2);
+}
+
+/*******************************************************/
+/*  Report the last button once the firmware is idle   */
+/*******************************************************/
+
+static void Report(void)
+{
+	tHostSimSSIStats sStats;
+
+	if (!g_pcPending) {
+		return;
+	}
+	HostSimSSIStatsGet(&sStats);
+	fprintf(stderr, "%-6s isr %8.3f us  busy %10.3f ms  oled %6lu cmd %6lu data bytes  %8.3f ms bus\n",
+		g_pcPending, g_dPendingISR * 1e6, (HostSimSeconds() - g_dPendingStart) * 1e3,
+		sStats.ulCommandBytes, sStats.ulDataBytes, sStats.dBusSeconds * 1e3);
+	g_pcPending = 0;
+}
+
+static void Finish(void)
+{
+	double dUs = 1e6 / SysCtlClockGet();
+	tRIT128x96x4QueueStats sQueue;
+	int i;
+
+	Report();
+	if (WeightsRestored) {
+		fprintf(stderr, "weights: restored from flash in %.3f us\n", RestoreCycles * dUs);
+	}
+	else {
+		fprintf(stderr, "weights seed: %lu\n", NNSeed);
+	}
+	fprintf(stderr, "worst case handler time: gpio %.3f us, adc %.3f us, systick %.3f us\n",
+		GPIOIntCyclesMax * dUs, ADCIntCyclesMax * dUs, SysTickIntCyclesMax * dUs);
+	RIT128x96x4QueueStatsGet(&sQueue);
+	fprintf(stderr, "oled queue: %lu runs, %lu bytes, max depth %lu, %lu full waits, %lu deferred flushes,"
+		" %lu drains\n", sQueue.ulBatches, sQueue.ulBytes, sQueue.ulMaxDepth, sQueue.ulFullWaits,
+		sQueue.ulDeferrals, OLEDTransfers);
+	if (TrainingControl.Epochs) {
+		fprintf(stderr, "training: %s after %lu epochs, error %.4f, best %.4f at %lu, %.3f us/epoch,"
+			" worst %.3f us\n", TrainControlReason(TrainingControl.Reason), TrainingControl.Epochs,
+			TrainingError, TrainingControl.BestError, TrainingControl.BestEpoch,
+			TrainControlCyclesPerEpoch(&TrainingControl) * dUs, TrainingControl.MaxCycles * dUs);
+	}
+	if (PlotFrames) {
+		fprintf(stderr, "training plot: %lu frames, %.1f%% of the training time\n",
+			PlotFrames, 100.0 * PlotCycles / (TrainingCycles ? TrainingCycles : 1));
+	}
+	if (StreamInferences) {
+		fprintf(stderr, "streaming: %lu inferences in %lu ticks, worst latency %.3f us\n",
+			StreamInferences, SysTickCount - StreamStartTick, StreamLatencyMax * dUs);
+	}
+#ifdef PROFILE
+	for (i = 0; i < PROFILE_MAX_SCOPES; i++) {
+		if (ProfileScopes[i].Name && ProfileScopes[i].Count) {
+			fprintf(stderr, "profile %-6s %8lu calls  min %8lu  mean %8lu  max %8lu " PROFILE_UNIT "\n",
+				ProfileScopes[i].Name, ProfileScopes[i].Count, ProfileScopes[i].Min,
+				ProfileMean(i), ProfileScopes[i].Max);
+		}
+	}
+#endif
+	if (!g_iQuiet) {
+		HostSimScreenPrint(stdout);
+	}
+	if (g_pcFlash && HostSimFlashSave(g_pcFlash)) {
+		fprintf(stderr, "cannot write %s\n", g_pcFlash);
+		exit(1);
+	}
+	if (g_pcPGM && HostSimScreenWritePGM(g_pcPGM)) {
+		fprintf(stderr, "cannot write %s\n", g_pcPGM);
+		exit(1);
+	}
+	exit(0);
+}
+
+/*******************************************************/
+/*  Idle hook: replay the next event of the script     */
+/*******************************************************/
+
+static void Idle(void)
+{
+	unsigned long ulCh0, ulCh1;
+	const char *pcEvent;
+	double dStart, dWait;
+	unsigned int i;
+
+	if (HostSimSeconds() < g_dWaitUntil || HostSimSSIBusy() || RIT128x96x4Pending()) {
+		return;
+	}
+	Report();
+	if (g_iScriptPos >= g_iScriptLen) {
+		Finish();
+	}
+	pcEvent = g_ppcScript[g_iScriptPos++];
+
+	if (strcmp(pcEvent, "show") == 0) {
+		HostSimScreenPrint(stdout);
+		fputc('\n', stdout);
+		return;
+	}
+	if (sscanf(pcEvent, "wait=%lf", &dWait) == 1) {
+		g_dWaitUntil = HostSimSeconds() + dWait * 1e-3;
+		return;
+	}
+	if (sscanf(pcEvent, "adc=%lu,%lu", &ulCh0, &ulCh1) == 2) {
+		HostSimADCSet(ulCh0, ulCh1);
+		return;
+	}
+
+	for (i = 0; i < sizeof(g_psButtons) / sizeof(g_psButtons[0]); i++) {
+		if (strcmp(pcEvent, g_psButtons[i].pcName) == 0) {
+			HostSimSSIStatsClear();
+			dStart = HostSimSeconds();
+			HostSimButtonPress(g_psButtons[i].ucPins);
+			g_dPendingISR = HostSimSeconds() - dStart;
+			g_dPendingStart = dStart;
+			g_pcPending = pcEvent;
+			return;
+		}
+	}
+
+	fprintf(stderr, "unknown event '%s'\n", pcEvent);
+	exit(2);
+}
+
+int main(int argc, char **argv)
+{
+	int i;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+			NNSeed = strtoul(argv[++i], 0, 0);
+		}
+		else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+			g_pcPGM = argv[++i];
+		}
+		else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+			g_pcFlash = argv[++i];
+			HostSimFlashLoad(g_pcFlash);	// a missing file is an erased flash
+		}
+		else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+			eta = (float)strtod(argv[++i], 0);
+		}
+		else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+			OptimizerMethod = (short)strtol(argv[++i], 0, 0);
+		}
+		else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+			ScheduleMode = (short)strtol(argv[++i], 0, 0);
+		}
+		else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+			PatternMode = (short)strtol(argv[++i], 0, 0);
+		}
+		else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc &&
+				 sscanf(argv[++i], "%hd,%hd", &InWeightsMode, &HidWeightsMode) == 2) {
+		}
+		else if (strcmp(argv[i], "-q") == 0) {
+			g_iQuiet = 1;
+		}
+		else {
+			Usage(argv[0]);
+		}
+	}
+	g_ppcScript = argv + i;
+	g_iScriptLen = argc - i;
+
+	HostSimIdleRegister(Idle);
+	return NNXORMain();
+}
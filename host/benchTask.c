@@ -0,0 +1,133 @@
+/*****************************************************************************************/
+/* Training benchmark tasks                                                              */
+/*                                                                                       */
+/* Tasks, runs and statistics shared by the training benchmarks, see benchTask.h.        */
+/*****************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "benchTask.h"
+#include "hostsim.h"
+
+const tBenchTask BenchTasks[BENCH_TASKS] = {
+	{"xor", {1.0, 0.1, 0.1, 1.0}},
+	{"and", {0.1, 0.1, 0.1, 1.0}},
+	{"or",  {0.1, 1.0, 1.0, 1.0}},
+};
+
+float BenchPatterns[NumPat][NumIn] = {{0.1,0.1},{0.1,1.0},{1.0,0.1},{1.0,1.0}};
+
+/*******************************************************/
+/*  Targets of task, zero weights and gradients,       */
+/*  online updates, and NNRandom seeded for the        */
+/*  initial weights.  A seed gives the same initial    */
+/*  weights to every configuration of a benchmark.     */
+/*******************************************************/
+
+static void BenchRunSetup(tBenchRun *run, const tBenchTask *task, int seed)
+{
+	memset(run, 0, sizeof(*run));
+	memcpy(run->Targets, task->Targets, sizeof(run->Targets));
+	run->Batch = 1;
+	PRNGSeed(&NNRandom, seed);
+}
+
+/* The weights the firmware draws from seed */
+void BenchRunInit(tBenchRun *run, const tBenchTask *task, int seed)
+{
+	BenchRunSetup(run, task, seed);
+	InWeightsInit(run->InW);
+	HidWeightsInit(run->HidW);
+}
+
+/* A WeightsInit() strategy per layer, the unused column 0 stays 0 */
+void BenchRunInitMode(tBenchRun *run, const tBenchTask *task, int seed, int inMode, int hidMode)
+{
+	BenchRunSetup(run, task, seed);
+	InWeightsInitMode(run->InW, inMode);
+	HidWeightsInitMode(run->HidW, hidMode);
+}
+
+/* Set up run->Opt for the weights of the network */
+void BenchRunOptimizer(tBenchRun *run, int method, float eta, int fixed)
+{
+	OptArenaInit(&run->Arena, run->ArenaMem, sizeof(run->ArenaMem));
+	OptimizerInit(&run->Opt, method, eta, fixed);
+	if (OptimizerWeights(&run->Opt, &run->Arena) != 0) {
+		printf("arena too small\n");
+		exit(1);
+	}
+}
+
+/*******************************************************/
+/*  Error over all the patterns, without training      */
+/*******************************************************/
+
+float BenchFullError(tBenchRun *run)
+{
+	float hidden[NumPat][NumHid+1], outputs[NumPat][NumOut+1];
+	float e, error=0;
+	int p;
+
+	ForwardBatch(BenchPatterns, NumPat, -1, -1, run->InW, hidden, run->HidW, outputs);
+	for (p=0; p<NumPat; p++) {
+		e=run->Targets[p]-outputs[p][1];
+		error+=0.5f*e*e;
+	}
+	return error;
+}
+
+/*******************************************************/
+/*  Epochs until epoch() reports convergence, or -1    */
+/*  after BENCH_MAX_EPOCHS                             */
+/*******************************************************/
+
+long BenchConverge(tBenchRun *run, tBenchEpoch epoch)
+{
+	long n;
+
+	for (n=1; n<=BENCH_MAX_EPOCHS; n++) {
+		if (epoch(run)) return n;
+	}
+	return -1;
+}
+
+/*******************************************************/
+/*  Statistics of the runs of one configuration        */
+/*******************************************************/
+
+void BenchStatsStart(tBenchStats *stats)
+{
+	memset(stats, 0, sizeof(*stats));
+	stats->Start = HostSimSeconds();
+}
+
+/* epochs of a run, -1 if it failed */
+void BenchStatsAdd(tBenchStats *stats, long epochs)
+{
+	stats->Runs++;
+	if (epochs<0) return;
+	stats->Converged++;
+	stats->Sum+=epochs;
+	if (epochs>stats->Max) stats->Max=epochs;
+}
+
+/* Mean epochs of the converged runs */
+double BenchStatsMean(const tBenchStats *stats)
+{
+	return stats->Converged ? (double)stats->Sum/stats->Converged : 0.0;
+}
+
+/* Mean epochs with the failed runs counted as BENCH_MAX_EPOCHS, which is */
+/* what a user waiting on the board sees                                  */
+double BenchStatsMeanAll(const tBenchStats *stats)
+{
+	return stats->Runs ? (stats->Sum+(double)(stats->Runs-stats->Converged)*BENCH_MAX_EPOCHS)/stats->Runs : 0.0;
+}
+
+/* Host time since BenchStatsStart() */
+double BenchStatsSeconds(const tBenchStats *stats)
+{
+	return HostSimSeconds()-stats->Start;
+}
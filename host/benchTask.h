@@ -0,0 +1,72 @@
+#ifndef BENCHTASK_H_
+#define BENCHTASK_H_
+
+/*****************************************************************************************/
+/* Training benchmark tasks                                                              */
+/*                                                                                       */
+/* What the training benchmarks share: the XOR, AND and OR targets of targetFlag (0.1/   */
+/* 1.0) on the four input patterns of the firmware, a run of the 2-2-1 network set up    */
+/* from a seed, the loop that counts the epochs until a run converges, and the           */
+/* converged, mean and worst epochs over the seeds.  A benchmark only supplies the epoch */
+/* it trains, as a tBenchEpoch.                                                          */
+/*****************************************************************************************/
+
+#include "supervisedNN.h"
+
+/************************************/
+/*	Definitions       				*/
+/************************************/
+#define BENCH_MAX_EPOCHS 20000		/* a run that needs more has failed		*/
+#define BENCH_TARGET_ERROR 0.05f	/* epoch error of the firmware			*/
+#define BENCH_TASKS 3
+#define BENCH_WEIGHTS ((NumIn+1)*(NumHid+1)+(NumHid+1)*(NumOut+1))
+
+typedef struct {
+	const char *Name;
+	float Targets[NumPat];
+} tBenchTask;
+
+/* One training run of the 2-2-1 network */
+typedef struct {
+	float InW[NumIn+1][NumHid+1];
+	float HidW[NumHid+1][NumOut+1];
+	float InG[NumIn+1][NumHid+1];			/* gradients, zero to start with	*/
+	float HidG[NumHid+1][NumOut+1];
+	float Targets[NumPat];
+	int Batch;								/* patterns per update, 1: online	*/
+	tOptimizer Opt;							/* set by BenchRunOptimizer()		*/
+	tOptArena Arena;
+	long long ArenaMem[OPT_ARENA_BYTES(BENCH_WEIGHTS, 2)/8+1];
+} tBenchRun;
+
+/* Trains one epoch of run, returns nonzero once it has converged */
+typedef int (*tBenchEpoch)(tBenchRun *run);
+
+/* Epochs to convergence of one configuration over its runs */
+typedef struct {
+	int Runs;
+	int Converged;
+	long Sum;								/* epochs of the converged runs		*/
+	long Max;
+	double Start;							/* HostSimSeconds()					*/
+} tBenchStats;
+
+extern const tBenchTask BenchTasks[BENCH_TASKS];
+extern float BenchPatterns[NumPat][NumIn];
+
+/************************************/
+/*	Prototype       				*/
+/************************************/
+
+extern void BenchRunInit(tBenchRun *run, const tBenchTask *task, int seed);
+extern void BenchRunInitMode(tBenchRun *run, const tBenchTask *task, int seed, int inMode, int hidMode);
+extern void BenchRunOptimizer(tBenchRun *run, int method, float eta, int fixed);
+extern float BenchFullError(tBenchRun *run);
+extern long BenchConverge(tBenchRun *run, tBenchEpoch epoch);
+extern void BenchStatsStart(tBenchStats *stats);
+extern void BenchStatsAdd(tBenchStats *stats, long epochs);
+extern double BenchStatsMean(const tBenchStats *stats);
+extern double BenchStatsMeanAll(const tBenchStats *stats);
+extern double BenchStatsSeconds(const tBenchStats *stats);
+
+#endif /*BENCHTASK_H_*/
@@ -0,0 +1,79 @@
+/*****************************************************************************************/
+/* Training controller benchmark                                                         */
+/*                                                                                       */
+/* Trains the 2-2-1 network as the firmware does (online, momentum, exponential eta      */
+/* schedule) on the XOR, AND and OR targets from NUM_SEEDS initializations, under the    */
+/* stop conditions of trainControl.h with BENCH_MAX_EPOCHS and several patience values.  */
+/* For each one it reports how the runs stopped, the mean epochs to the stop, the total  */
+/* epochs spent, and the runs stopped for patience that would have converged within      */
+/* BENCH_MAX_EPOCHS (lost).  The cycles given to the controller are host nanoseconds,    */
+/* and the mean per epoch is reported.                                                   */
+/*****************************************************************************************/
+
+#include <stdio.h>
+#include "benchTask.h"
+#include "schedule.h"
+#include "trainControl.h"
+#include "hostsim.h"
+
+#define NUM_SEEDS 256
+
+static const unsigned long Patience[] = {0, 250, 500, 1000, 2000};
+
+static const float Eta = 0.1;
+static long Reference[NUM_SEEDS+1];
+
+/* Trains until the controller stops, returns the reason */
+static int Train(const tBenchTask *task, unsigned long patience, int seed, tTrainControl *ctl)
+{
+	tBenchRun run;
+	tSchedule sched;
+	float error;
+	double start;
+
+	BenchRunInit(&run, task, seed);
+	BenchRunOptimizer(&run, OPT_MOMENTUM, Eta, 0);
+	ScheduleInit(&sched, SCHED_EXP, Eta);
+	TrainControlInit(ctl, BENCH_MAX_EPOCHS, BENCH_TARGET_ERROR, patience, 0);
+	do {
+		start=HostSimSeconds();
+		error=TrainEpochOpt(BenchPatterns, run.Targets, 0, NumPat, 1, -1, -1, run.InW, run.HidW, run.InG, run.HidG, &run.Opt);
+		OptimizerSetEta(&run.Opt, ScheduleUpdate(&sched, error));
+	} while (TrainControlEpoch(ctl, error, (unsigned long)((HostSimSeconds()-start)*1e9)) == STOP_NONE);
+	return ctl->Reason;
+}
+
+int main(void)
+{
+	tTrainControl ctl;
+	long count[STOP_REASONS], lost, epochs, spent;
+	double ns;
+	int t, i, r, seed;
+
+	printf("task  patience  converged  epochs  stalled  lost  mean epochs  total epochs  ns/epoch\n");
+	for (t=0; t<BENCH_TASKS; t++) {
+		for (i=0; i<(int)(sizeof(Patience)/sizeof(Patience[0])); i++) {
+			for (r=0; r<STOP_REASONS; r++) count[r]=0;
+			lost=0;
+			spent=0;
+			ns=0;
+			for (seed=1; seed<=NUM_SEEDS; seed++) {
+				r=Train(&BenchTasks[t], Patience[i], seed, &ctl);
+				count[r]++;
+				spent+=ctl.Epochs;
+				ns+=ctl.Cycles;
+				if (Patience[i]==0) {
+					Reference[seed]=(r==STOP_CONVERGED) ? (long)ctl.Epochs : -1;
+				}
+				else if (r==STOP_PATIENCE && Reference[seed]>=0) {
+					lost++;
+				}
+			}
+			epochs=spent/NUM_SEEDS;
+			printf("%-5s %8lu  %9ld  %6ld  %7ld  %4ld  %11ld  %12ld  %8.1f\n", BenchTasks[t].Name, Patience[i],
+				count[STOP_CONVERGED], count[STOP_EPOCHS], count[STOP_PATIENCE], lost, epochs, spent,
+				ns/spent);
+		}
+	}
+	return 0;
+}
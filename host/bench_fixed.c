@@ -0,0 +1,110 @@
+/*****************************************************************************************/
+/* Fixed point benchmark                                                                 */
+/*                                                                                       */
+/* Trains the XOR network from the same random weights with the float path and the Q15  */
+/* path, and reports epochs per second, the epoch at which the error first drops below  */
+/* 0.05 and the final error.  The host has an FPU, so the float path is much cheaper    */
+/* here than on the soft-float Cortex-M3.                                                */
+/*****************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "supervisedNN.h"
+#include "supervisedNNFixed.h"
+#include "hostsim.h"
+
+#define NUM_EPOCHS 20000
+#define NUM_SEEDS 8
+
+static const float Patterns[NumPat][NumIn] = {{0.1,0.1},{0.1,1.0},{1.0,0.1},{1.0,1.0}};
+static const float Targets[NumPat] = {1.0, 0.1, 0.1, 1.0};
+static const float Eta = 0.1;
+
+static float InWeights[NumIn+1][NumHid+1];
+static float HidWeights[NumHid+1][NumOut+1];
+
+static double TrainFloat(float InW[][NumHid+1], float HidW[][NumOut+1], long *converged, float *finalError)
+{
+	float inputs[NumIn+1], hidden[NumHid+1], outputs[NumOut+1], target[NumOut+1];
+	float error=0;
+	double start=HostSimSeconds();
+	long epoch;
+	int p;
+
+	*converged=-1;
+	inputs[0]=-1;
+	hidden[0]=-1;
+	for (epoch=1; epoch<=NUM_EPOCHS; epoch++) {
+		error=0;
+		for (p=0; p<NumPat; p++) {
+			inputs[1]=Patterns[p][0];
+			inputs[2]=Patterns[p][1];
+			target[1]=Targets[p];
+			Forward(inputs, InW, hidden, HidW, outputs);
+			error+=0.5f*(target[1]-outputs[1])*(target[1]-outputs[1]);
+			BackPropagation(target, inputs, InW, hidden, HidW, outputs, Eta);
+		}
+		if (*converged<0 && error<0.05f) *converged=epoch;
+	}
+	*finalError=error;
+	return HostSimSeconds()-start;
+}
+
+static double TrainQ15(long InW[][NumHid+1], long HidW[][NumOut+1], long *converged, float *finalError)
+{
+	long inputs[NumIn+1], hidden[NumHid+1], outputs[NumOut+1], target[NumOut+1];
+	long eta=FloatToQ15(Eta);
+	long e, error=0;
+	double start=HostSimSeconds();
+	long epoch;
+	int p;
+
+	*converged=-1;
+	inputs[0]=-Q15_ONE;
+	hidden[0]=-Q15_ONE;
+	for (epoch=1; epoch<=NUM_EPOCHS; epoch++) {
+		error=0;
+		for (p=0; p<NumPat; p++) {
+			inputs[1]=FloatToQ15(Patterns[p][0]);
+			inputs[2]=FloatToQ15(Patterns[p][1]);
+			target[1]=FloatToQ15(Targets[p]);
+			ForwardQ15(inputs, InW, hidden, HidW, outputs);
+			e=target[1]-outputs[1];
+			error+=Q15Mul(e,e)/2;
+			BackPropagationQ15(target, inputs, InW, hidden, HidW, outputs, eta);
+		}
+		if (*converged<0 && error<FloatToQ15(0.05f)) *converged=epoch;
+	}
+	*finalError=Q15ToFloat(error);
+	return HostSimSeconds()-start;
+}
+
+int main(void)
+{
+	float InW[NumIn+1][NumHid+1], HidW[NumHid+1][NumOut+1];
+	long InWQ[NumIn+1][NumHid+1], HidWQ[NumHid+1][NumOut+1];
+	double tFloat=0, tQ15=0;
+	long convFloat, convQ15;
+	float errFloat, errQ15;
+	int seed;
+
+	printf("seed  float: converged  error     Q15: converged  error\n");
+	for (seed=1; seed<=NUM_SEEDS; seed++) {
+		PRNGSeed(&NNRandom, seed);
+		InWeightsInit(InWeights);
+		HidWeightsInit(HidWeights);
+
+		memcpy(InW, InWeights, sizeof(InW));
+		memcpy(HidW, HidWeights, sizeof(HidW));
+		tFloat+=TrainFloat(InW, HidW, &convFloat, &errFloat);
+
+		WeightsToQ15(InWeights, HidWeights, InWQ, HidWQ);
+		tQ15+=TrainQ15(InWQ, HidWQ, &convQ15, &errQ15);
+
+		printf("%4d  %16ld  %.4f  %16ld  %.4f\n", seed, convFloat, errFloat, convQ15, errQ15);
+	}
+	printf("float: %.0f epochs/s\n", NUM_SEEDS*NUM_EPOCHS/tFloat);
+	printf("Q15:   %.0f epochs/s\n", NUM_SEEDS*NUM_EPOCHS/tQ15);
+	return 0;
+}
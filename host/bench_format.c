@@ -0,0 +1,166 @@
+/*****************************************************************************************/
+/* Number formatting benchmark                                                           */
+/*                                                                                       */
+/* Compares FloatStr()/UDecStr() from the OLED driver against sprintf("%.4f"),           */
+/* sprintf("%.2f") and sprintf("%lu") on the values the firmware displays: host time per */
+/* call and the number of strings that differ from sprintf.  FloatStr() rounds half away */
+/* from zero while sprintf rounds the exact binary value to even, so the two can differ  */
+/* in the last digit when the value is within a float rounding error of a tie.  On the   */
+/* soft-float Cortex-M3 the gap is much wider than here, and sprintf also costs the ~4.7 */
+/* KB of printf library code and tables listed in Debug/NN_XOR.map.  It also checks that */
+/* the values around the 32 bit limit of each number of decimals print as "*" or as a   */
+/* number that fits in 32 bits, never as one that would wrap on the target.             */
+/*****************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "supervisedNN.h"
+#include "hostsim.h"
+#include "inc/hw_types.h"
+#include "Drivers/rit128x96x4.h"
+
+#define NUM_SAMPLES 4096
+#define NUM_ROUNDS 200
+
+static float Samples[NUM_SAMPLES];
+static unsigned long Counts[NUM_SAMPLES];
+volatile char Sink;
+
+static void FloatBench(const char *name, unsigned long decimals)
+{
+	char fmt[8], ref[32], str[32], firstRef[32], firstStr[32];
+	double start, tPrintf, tFloatStr;
+	long mismatches=0;
+	int r, i;
+
+	sprintf(fmt, "%%.%luf", decimals);
+	for (i=0; i<NUM_SAMPLES; i++) {
+		sprintf(ref, fmt, Samples[i]);
+		FloatStr(Samples[i], decimals, str);
+		if (strcmp(ref, str) != 0) {
+			if (mismatches==0) {
+				strcpy(firstRef, ref);
+				strcpy(firstStr, str);
+			}
+			mismatches++;
+		}
+	}
+
+	start=HostSimSeconds();
+	for (r=0; r<NUM_ROUNDS; r++) {
+		for (i=0; i<NUM_SAMPLES; i++) {
+			sprintf(str, fmt, Samples[i]);
+			Sink+=str[0];
+		}
+	}
+	tPrintf=HostSimSeconds()-start;
+
+	start=HostSimSeconds();
+	for (r=0; r<NUM_ROUNDS; r++) {
+		for (i=0; i<NUM_SAMPLES; i++) {
+			FloatStr(Samples[i], decimals, str);
+			Sink+=str[0];
+		}
+	}
+	tFloatStr=HostSimSeconds()-start;
+
+	printf("%-8s sprintf %7.2f ns  FloatStr %7.2f ns  speedup %5.1fx  mismatches %ld/%d\n",
+		name, tPrintf*1e9/((double)NUM_ROUNDS*NUM_SAMPLES), tFloatStr*1e9/((double)NUM_ROUNDS*NUM_SAMPLES),
+		tPrintf/tFloatStr, mismatches, NUM_SAMPLES);
+	if (mismatches) printf("  first %s mismatch: sprintf \"%s\" FloatStr \"%s\"\n", name, firstRef, firstStr);
+}
+
+static void IntBench(void)
+{
+	char ref[32], str[32];
+	double start, tPrintf, tUDecStr;
+	long mismatches=0;
+	int r, i;
+
+	for (i=0; i<NUM_SAMPLES; i++) {
+		sprintf(ref, "%lu", Counts[i]);
+		UDecStr(Counts[i], str);
+		if (strcmp(ref, str) != 0) mismatches++;
+	}
+
+	start=HostSimSeconds();
+	for (r=0; r<NUM_ROUNDS; r++) {
+		for (i=0; i<NUM_SAMPLES; i++) {
+			sprintf(str, "%lu", Counts[i]);
+			Sink+=str[0];
+		}
+	}
+	tPrintf=HostSimSeconds()-start;
+
+	start=HostSimSeconds();
+	for (r=0; r<NUM_ROUNDS; r++) {
+		for (i=0; i<NUM_SAMPLES; i++) {
+			UDecStr(Counts[i], str);
+			Sink+=str[0];
+		}
+	}
+	tUDecStr=HostSimSeconds()-start;
+
+	printf("%-8s sprintf %7.2f ns  UDecStr  %7.2f ns  speedup %5.1fx  mismatches %ld/%d\n",
+		"%lu", tPrintf*1e9/((double)NUM_ROUNDS*NUM_SAMPLES), tUDecStr*1e9/((double)NUM_ROUNDS*NUM_SAMPLES),
+		tPrintf/tUDecStr, mismatches, NUM_SAMPLES);
+}
+
+/* Digits of a formatted number without the point, as an integer */
+static unsigned long long Scaled(const char *str)
+{
+	unsigned long long value=0;
+
+	for (; *str; str++) {
+		if (*str!='.') value=value*10+(*str-'0');
+	}
+	return value;
+}
+
+/* The 128 floats around 2^32/10^decimals, some with a fraction that rounds */
+/* up: "*", or digits that fit in 32 bits.  unsigned long is 64 bits on the  */
+/* host, so a number that would wrap on the target shows up as too large     */
+static int LimitCheck(void)
+{
+	char fmt[8], ref[64], str[64];
+	unsigned long decimals;
+	unsigned long long value;
+	float x, limit;
+	int errors=0, i, k;
+
+	for (decimals=0; decimals<10; decimals++) {
+		sprintf(fmt, "%%.%luf", decimals);
+		limit=4294967296.0f;
+		for (k=0; k<(int)decimals; k++) limit/=10;
+		x=limit;
+		for (i=0; i<64; i++) x=nextafterf(x, 0);
+		for (i=0; i<128; i++, x=nextafterf(x, limit*2)) {
+			sprintf(ref, fmt, x);
+			FloatStr(x, decimals, str);
+			if (strcmp(str, "*")==0) continue;
+			value=Scaled(str);
+			if (value>0xFFFFFFFFULL) {
+				if (errors==0) printf("  limit: %.9g with %lu decimals, sprintf \"%s\" FloatStr \"%s\"\n", x, decimals, ref, str);
+				errors++;
+			}
+		}
+	}
+	printf("limit    %d numbers above 32 bits around 2^32/10^decimals\n", errors);
+	return errors;
+}
+
+int main(void)
+{
+	int i;
+
+	/* weights and errors are within a few units of 0 */
+	for (i=0; i<NUM_SAMPLES; i++) {
+		Samples[i]=getrandom_f(-4.0, 4.0);
+		Counts[i]=(unsigned long)getrandom_f(0, 100000.0);
+	}
+	FloatBench("%.4f", 4);
+	FloatBench("%.2f", 2);
+	IntBench();
+	return LimitCheck() ? 1 : 0;
+}
@@ -0,0 +1,60 @@
+/*****************************************************************************************/
+/* Weights initialization benchmark                                                      */
+/*                                                                                       */
+/* Trains the 2-2-1 network of the firmware (online, eta 0.1, targets 0.1/1.0) on XOR,   */
+/* AND and OR from NUM_SEEDS initializations per WeightsInit() strategy, given for the   */
+/* input and the hidden layer.  Reports the runs that reach an epoch error below         */
+/* BENCH_TARGET_ERROR within BENCH_MAX_EPOCHS, the mean and worst epochs of those, and   */
+/* the mean with the failed runs counted as BENCH_MAX_EPOCHS.  The hidden layer of the   */
+/* 2-2-1 network is not square, so INIT_ORTHOGONAL falls back to INIT_XAVIER_NORMAL      */
+/* there.                                                                                */
+/*****************************************************************************************/
+
+#include <stdio.h>
+#include "benchTask.h"
+
+#define NUM_SEEDS 100
+
+static const char *ModeNames[] = {"uniform", "xavier", "xavier-n", "he", "he-n", "ortho"};
+
+/* input layer, hidden layer */
+static const int Modes[][2] = {
+	{INIT_UNIFORM,       INIT_UNIFORM},
+	{INIT_XAVIER,        INIT_XAVIER},
+	{INIT_XAVIER_NORMAL, INIT_XAVIER_NORMAL},
+	{INIT_HE,            INIT_HE},
+	{INIT_HE_NORMAL,     INIT_HE_NORMAL},
+	{INIT_ORTHOGONAL,    INIT_XAVIER_NORMAL},
+	{INIT_ORTHOGONAL,    INIT_XAVIER},
+	{INIT_XAVIER,        INIT_UNIFORM},
+	{INIT_UNIFORM,       INIT_XAVIER},
+};
+
+static const float Eta = 0.1;
+
+static int InitEpoch(tBenchRun *run)
+{
+	return TrainEpoch(BenchPatterns, run->Targets, NumPat, 1, -1, -1, run->InW, run->HidW, run->InG, run->HidG, Eta)<BENCH_TARGET_ERROR;
+}
+
+int main(void)
+{
+	tBenchRun run;
+	tBenchStats stats;
+	int t, m, seed;
+
+	printf("task  input     hidden    converged  epochs mean    max  with failures\n");
+	for (t=0; t<BENCH_TASKS; t++) {
+		for (m=0; m<(int)(sizeof(Modes)/sizeof(Modes[0])); m++) {
+			BenchStatsStart(&stats);
+			for (seed=1; seed<=NUM_SEEDS; seed++) {
+				BenchRunInitMode(&run, &BenchTasks[t], seed, Modes[m][0], Modes[m][1]);
+				BenchStatsAdd(&stats, BenchConverge(&run, InitEpoch));
+			}
+			printf("%-5s %-9s %-9s %5d/%-3d  %11.1f %6ld  %13.1f\n", BenchTasks[t].Name,
+				ModeNames[Modes[m][0]], ModeNames[Modes[m][1]], stats.Converged, NUM_SEEDS,
+				BenchStatsMean(&stats), stats.Max, BenchStatsMeanAll(&stats));
+		}
+	}
+	return 0;
+}
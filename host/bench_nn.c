@@ -0,0 +1,503 @@
+/*****************************************************************************************/
+/* Neural network benchmark                                                              */
+/*                                                                                       */
+/* Sweeps topologies, sigmoids and batch sizes and prints one CSV row per combination:   */
+/* Forward() and BackPropagation() latency, time per epoch, and over NUM_SEEDS random    */
+/* initializations the number of runs that reach an error below 0.05 within MAX_EPOCHS, */
+/* the mean and worst epochs to get there and the mean wall time it took.  The sigmoids */
+/* are the table (the firmware default, sigmoidTable()), single precision expf() and    */
+/* the double precision sigmoid().  Each topology is an instantiation of                */
+/* supervisedNNSized.h; the "lib" row runs the Forward(), BackPropagation() and         */
+/* TrainEpoch() of supervisedNN.c as the firmware calls them.  Topologies with a task   */
+/* are trained on it (XOR, 3 bit parity), the others are timed only ("-" fields).       */
+/*                                                                                       */
+/*     bench_nn [-e eta] > baseline.csv                                                  */
+/*     bench_nn [-e eta] -c baseline.csv [-t percent] > results.csv                      */
+/*                                                                                       */
+/* With -c the rows are also compared with a previous run, and the regressions are       */
+/* reported on stderr with exit status 1: fewer runs converging, or more than            */
+/* EPOCH_TOLERANCE % more epochs to converge.  The epoch counts only depend on the       */
+/* arithmetic, so they repeat exactly on one host and any change means that              */
+/* supervisedNN.c computes something else.  -t also flags calls and epochs that got      */
+/* slower by more than that percentage; the host timings can differ by half from one run */
+/* to the next on a virtual machine, so use a wide tolerance there.                      */
+/*****************************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "supervisedNN.h"
+#include "hostsim.h"
+
+#define NUM_SEEDS 8
+#define MAX_EPOCHS 20000
+#define TARGET_ERROR 0.05f
+#define LATENCY_CALLS 2000
+#define LATENCY_BATCHES 20		/* the best batch is kept, to filter out host noise */
+#define MAX_ROWS 64
+#define EPOCH_TOLERANCE 10		/* % more epochs to converge that is a regression */
+
+static float Eta = 0.1;
+volatile float Sink;
+
+/*******************************************************/
+/*  Sigmoids                                           */
+/*******************************************************/
+
+static __inline float SigmoidFloat(float x)
+{
+	return 1.0f/(1.0f+expf(-x));
+}
+
+/*******************************************************/
+/*  Tasks                                              */
+/*******************************************************/
+
+typedef struct {
+	const char *Name;
+	int Count;			/* patterns */
+	float *Patterns;		/* Count rows of the inputs of the network */
+	float *Targets;			/* Count rows of the outputs */
+} tTask;
+
+static float XORPatterns[4][2] = {{0.1,0.1},{0.1,1.0},{1.0,0.1},{1.0,1.0}};
+static float XORTargets[4] = {1.0, 0.1, 0.1, 1.0};
+static const tTask XORTask = {"xor", 4, &XORPatterns[0][0], XORTargets};
+
+static float ParityPatterns[8][3] = {{0.1,0.1,0.1},{0.1,0.1,1.0},{0.1,1.0,0.1},{0.1,1.0,1.0},
+									 {1.0,0.1,0.1},{1.0,0.1,1.0},{1.0,1.0,0.1},{1.0,1.0,1.0}};
+static float ParityTargets[8] = {1.0, 0.1, 0.1, 1.0, 0.1, 1.0, 1.0, 0.1};
+static const tTask ParityTask = {"parity3", 8, &ParityPatterns[0][0], ParityTargets};
+
+/*******************************************************/
+/*  Results                                            */
+/*******************************************************/
+
+typedef struct {
+	char Topology[16];
+	char Task[16];
+	char Sigmoid[16];
+	int Batch;
+	double ForwardNs;
+	double BackpropNs;
+	double EpochNs;				/* negative: not trained */
+	int Converged;
+	double EpochsMean;
+	long EpochsMax;
+	double ConvergeMs;
+} tResult;
+
+static tResult Results[MAX_ROWS];
+static int NumResults;
+
+/*******************************************************/
+/*  Runners for one instantiation of the template      */
+/*  name##Latency() times one Forward() and one        */
+/*  BackPropagation(), name##Converge() trains a task  */
+/*  from NUM_SEEDS initializations.                    */
+/*******************************************************/
+
+#define BENCH_RUNNERS(name, in, hid, out)														\
+static void name##Latency(tResult *r)															\
+{																								\
+	name##Net net;																				\
+	float target[out+1];																		\
+	double start, t;																			\
+	int b, n;																					\
+																								\
+	PRNGSeed(&NNRandom, 1);																		\
+	name##NetInit(&net, -1);																	\
+	for (n=1; n<=in; n++) net.Inputs[n]=0.1f*n;													\
+	for (n=1; n<=out; n++) target[n]=0.5f;														\
+	r->ForwardNs=r->BackpropNs=1e9;																\
+	for (b=0; b<LATENCY_BATCHES; b++) {															\
+		start=HostSimSeconds();																	\
+		for (n=0; n<LATENCY_CALLS; n++) {														\
+			net.Inputs[1]=(n&1) ? 0.1f : 1.0f;													\
+			name##NetForward(&net);																\
+			Sink+=net.Outputs[1];																\
+		}																						\
+		t=(HostSimSeconds()-start)*1e9/LATENCY_CALLS;											\
+		if (t<r->ForwardNs) r->ForwardNs=t;														\
+		start=HostSimSeconds();																	\
+		for (n=0; n<LATENCY_CALLS; n++) {														\
+			name##NetBackPropagation(&net, target, 0.001f);										\
+		}																						\
+		t=(HostSimSeconds()-start)*1e9/LATENCY_CALLS;											\
+		Sink+=net.HidWeights[0][1];																\
+		if (t<r->BackpropNs) r->BackpropNs=t;													\
+	}																							\
+}																								\
+																								\
+static void name##Converge(const tTask *task, int batch, tResult *r)							\
+{																								\
+	float InW[in+1][hid+1], HidW[hid+1][out+1], InG[in+1][hid+1], HidG[hid+1][out+1];			\
+	double start, t, time=0, convergeTime=0;													\
+	long epoch, epochs=0, convergeEpochs=0;														\
+	float error;																				\
+	int seed;																					\
+																								\
+	r->Converged=0;																				\
+	r->EpochsMax=0;																				\
+	for (seed=1; seed<=NUM_SEEDS; seed++) {														\
+		PRNGSeed(&NNRandom, seed);																\
+		name##InWeightsInit(InW);																\
+		name##HidWeightsInit(HidW);																\
+		memset(InG, 0, sizeof(InG));															\
+		memset(HidG, 0, sizeof(HidG));															\
+		start=HostSimSeconds();																	\
+		for (epoch=1; epoch<=MAX_EPOCHS; epoch++) {												\
+			error=name##TrainEpoch((float (*)[in])task->Patterns, task->Targets, task->Count,	\
+				batch, -1, -1, InW, HidW, InG, HidG, Eta);										\
+			if (error<TARGET_ERROR) break;														\
+		}																						\
+		t=HostSimSeconds()-start;																\
+		time+=t;																				\
+		if (epoch<=MAX_EPOCHS) {																\
+			r->Converged++;																		\
+			convergeEpochs+=epoch;																\
+			convergeTime+=t;																	\
+			if (epoch>r->EpochsMax) r->EpochsMax=epoch;											\
+		}																						\
+		else epoch=MAX_EPOCHS;																	\
+		epochs+=epoch;																			\
+	}																							\
+	r->EpochNs=time*1e9/epochs;																	\
+	r->EpochsMean=r->Converged ? (double)convergeEpochs/r->Converged : 0;						\
+	r->ConvergeMs=r->Converged ? convergeTime*1e3/r->Converged : 0;								\
+}
+
+/*******************************************************/
+/*  Instantiations: every topology with each sigmoid   */
+/*******************************************************/
+
+#undef NN_SIGMOID
+#define NN_SIGMOID(x) sigmoidTable(x)
+#define NN_NAME T221
+#define NN_IN 2
+#define NN_HID 2
+#define NN_OUT 1
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(T221, 2, 2, 1)
+#define NN_NAME T241
+#define NN_IN 2
+#define NN_HID 4
+#define NN_OUT 1
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(T241, 2, 4, 1)
+#define NN_NAME T281
+#define NN_IN 2
+#define NN_HID 8
+#define NN_OUT 1
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(T281, 2, 8, 1)
+#define NN_NAME T361
+#define NN_IN 3
+#define NN_HID 6
+#define NN_OUT 1
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(T361, 3, 6, 1)
+#define NN_NAME T8164
+#define NN_IN 8
+#define NN_HID 16
+#define NN_OUT 4
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(T8164, 8, 16, 4)
+
+#undef NN_SIGMOID
+#define NN_SIGMOID(x) SigmoidFloat(x)
+#define NN_NAME F221
+#define NN_IN 2
+#define NN_HID 2
+#define NN_OUT 1
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(F221, 2, 2, 1)
+#define NN_NAME F241
+#define NN_IN 2
+#define NN_HID 4
+#define NN_OUT 1
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(F241, 2, 4, 1)
+#define NN_NAME F281
+#define NN_IN 2
+#define NN_HID 8
+#define NN_OUT 1
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(F281, 2, 8, 1)
+#define NN_NAME F361
+#define NN_IN 3
+#define NN_HID 6
+#define NN_OUT 1
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(F361, 3, 6, 1)
+#define NN_NAME F8164
+#define NN_IN 8
+#define NN_HID 16
+#define NN_OUT 4
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(F8164, 8, 16, 4)
+
+#undef NN_SIGMOID
+#define NN_SIGMOID(x) sigmoid(x)
+#define NN_NAME D221
+#define NN_IN 2
+#define NN_HID 2
+#define NN_OUT 1
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(D221, 2, 2, 1)
+#define NN_NAME D241
+#define NN_IN 2
+#define NN_HID 4
+#define NN_OUT 1
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(D241, 2, 4, 1)
+#define NN_NAME D281
+#define NN_IN 2
+#define NN_HID 8
+#define NN_OUT 1
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(D281, 2, 8, 1)
+#define NN_NAME D361
+#define NN_IN 3
+#define NN_HID 6
+#define NN_OUT 1
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(D361, 3, 6, 1)
+#define NN_NAME D8164
+#define NN_IN 8
+#define NN_HID 16
+#define NN_OUT 4
+#include "supervisedNNSized.h"
+BENCH_RUNNERS(D8164, 8, 16, 4)
+
+/*******************************************************/
+/*  The library functions of supervisedNN.c            */
+/*******************************************************/
+
+static void LibLatency(tResult *r)
+{
+	float inputs[NumIn+1], hidden[NumHid+1], outputs[NumOut+1], target[NumOut+1];
+	float InW[NumIn+1][NumHid+1], HidW[NumHid+1][NumOut+1];
+	double start, t;
+	int b, n;
+
+	PRNGSeed(&NNRandom, 1);
+	InWeightsInit(InW);
+	HidWeightsInit(HidW);
+	inputs[0]=hidden[0]=-1;
+	inputs[2]=0.5f;
+	target[1]=0.5f;
+	r->ForwardNs=r->BackpropNs=1e9;
+	for (b=0; b<LATENCY_BATCHES; b++) {
+		start=HostSimSeconds();
+		for (n=0; n<LATENCY_CALLS; n++) {
+			inputs[1]=(n&1) ? 0.1f : 1.0f;
+			Forward(inputs, InW, hidden, HidW, outputs);
+			Sink+=outputs[1];
+		}
+		t=(HostSimSeconds()-start)*1e9/LATENCY_CALLS;
+		if (t<r->ForwardNs) r->ForwardNs=t;
+		start=HostSimSeconds();
+		for (n=0; n<LATENCY_CALLS; n++) {
+			BackPropagation(target, inputs, InW, hidden, HidW, outputs, 0.001f);
+		}
+		t=(HostSimSeconds()-start)*1e9/LATENCY_CALLS;
+		Sink+=HidW[0][1];
+		if (t<r->BackpropNs) r->BackpropNs=t;
+	}
+}
+
+static void LibConverge(const tTask *task, int batch, tResult *r)
+{
+	float InW[NumIn+1][NumHid+1], HidW[NumHid+1][NumOut+1], InG[NumIn+1][NumHid+1], HidG[NumHid+1][NumOut+1];
+	double start, t, time=0, convergeTime=0;
+	long epoch, epochs=0, convergeEpochs=0;
+	float error;
+	int seed;
+
+	r->Converged=0;
+	r->EpochsMax=0;
+	for (seed=1; seed<=NUM_SEEDS; seed++) {
+		PRNGSeed(&NNRandom, seed);
+		InWeightsInit(InW);
+		HidWeightsInit(HidW);
+		memset(InG, 0, sizeof(InG));
+		memset(HidG, 0, sizeof(HidG));
+		start=HostSimSeconds();
+		for (epoch=1; epoch<=MAX_EPOCHS; epoch++) {
+			error=TrainEpoch((float (*)[NumIn])task->Patterns, task->Targets, task->Count,
+				batch, -1, -1, InW, HidW, InG, HidG, Eta);
+			if (error<TARGET_ERROR) break;
+		}
+		t=HostSimSeconds()-start;
+		time+=t;
+		if (epoch<=MAX_EPOCHS) {
+			r->Converged++;
+			convergeEpochs+=epoch;
+			convergeTime+=t;
+			if (epoch>r->EpochsMax) r->EpochsMax=epoch;
+		}
+		else epoch=MAX_EPOCHS;
+		epochs+=epoch;
+	}
+	r->EpochNs=time*1e9/epochs;
+	r->EpochsMean=r->Converged ? (double)convergeEpochs/r->Converged : 0;
+	r->ConvergeMs=r->Converged ? convergeTime*1e3/r->Converged : 0;
+}
+
+/*******************************************************/
+/*  The sweep                                          */
+/*******************************************************/
+
+typedef struct {
+	const char *Topology;
+	const char *Sigmoid;
+	const tTask *Task;		/* null: timed only */
+	void (*Latency)(tResult *r);
+	void (*Converge)(const tTask *task, int batch, tResult *r);
+} tCase;
+
+static const tCase Cases[] = {
+	{"lib-2-2-1", SIGMOID_MODE == SIGMOID_TABLE ? "table" : "double", &XORTask, LibLatency, LibConverge},
+	{"2-2-1",  "table",  &XORTask,    T221Latency,  T221Converge},
+	{"2-4-1",  "table",  &XORTask,    T241Latency,  T241Converge},
+	{"2-8-1",  "table",  &XORTask,    T281Latency,  T281Converge},
+	{"3-6-1",  "table",  &ParityTask, T361Latency,  T361Converge},
+	{"8-16-4", "table",  0,           T8164Latency, T8164Converge},
+	{"2-2-1",  "float",  &XORTask,    F221Latency,  F221Converge},
+	{"2-4-1",  "float",  &XORTask,    F241Latency,  F241Converge},
+	{"2-8-1",  "float",  &XORTask,    F281Latency,  F281Converge},
+	{"3-6-1",  "float",  &ParityTask, F361Latency,  F361Converge},
+	{"8-16-4", "float",  0,           F8164Latency, F8164Converge},
+	{"2-2-1",  "double", &XORTask,    D221Latency,  D221Converge},
+	{"2-4-1",  "double", &XORTask,    D241Latency,  D241Converge},
+	{"2-8-1",  "double", &XORTask,    D281Latency,  D281Converge},
+	{"3-6-1",  "double", &ParityTask, D361Latency,  D361Converge},
+	{"8-16-4", "double", 0,           D8164Latency, D8164Converge},
+};
+
+static const int Batches[] = {1, 2, 4};
+
+#define CSV_HEADER "topology,task,sigmoid,batch,forward_ns,backprop_ns,epoch_ns,seeds,converged,epochs_mean,epochs_max,converge_ms"
+
+static void PrintResult(const tResult *r)
+{
+	printf("%s,%s,%s,%d,%.1f,%.1f,", r->Topology, r->Task, r->Sigmoid, r->Batch, r->ForwardNs, r->BackpropNs);
+	if (r->EpochNs<0) {
+		printf("-,-,-,-,-,-\n");
+	}
+	else {
+		printf("%.1f,%d,%d,%.1f,%ld,%.3f\n", r->EpochNs, NUM_SEEDS, r->Converged, r->EpochsMean, r->EpochsMax, r->ConvergeMs);
+	}
+}
+
+static void RunCases(void)
+{
+	const tCase *c;
+	tResult *r;
+	unsigned int i, b;
+
+	for (i=0; i<sizeof(Cases)/sizeof(Cases[0]); i++) {
+		c=&Cases[i];
+		for (b=0; b<sizeof(Batches)/sizeof(Batches[0]); b++) {
+			if ((b>0) && !c->Task) break;
+			r=&Results[NumResults++];
+			snprintf(r->Topology, sizeof(r->Topology), "%s", c->Topology);
+			snprintf(r->Task, sizeof(r->Task), "%s", c->Task ? c->Task->Name : "-");
+			snprintf(r->Sigmoid, sizeof(r->Sigmoid), "%s", c->Sigmoid);
+			r->Batch=Batches[b];
+			c->Latency(r);
+			r->EpochNs=-1;
+			if (c->Task) c->Converge(c->Task, Batches[b], r);
+			PrintResult(r);
+			fflush(stdout);
+		}
+	}
+}
+
+/*******************************************************/
+/*  Comparison with a previous run                     */
+/*******************************************************/
+
+static int Worse(const char *what, const tResult *r, double base, double now, double tolerance)
+{
+	if (now<=base*(1+tolerance/100)) return 0;
+	fprintf(stderr, "regression: %s %s %s batch %d: %s %.1f -> %.1f\n",
+		r->Topology, r->Task, r->Sigmoid, r->Batch, what, base, now);
+	return 1;
+}
+
+static int Compare(const char *filename, double tolerance)
+{
+	char line[256], topology[16], task[16], sigmoid[16], epochNs[32], epochsMean[32];
+	double forwardNs, backprop;
+	int batch, converged, i, found, regressions=0;
+	const tResult *r;
+	FILE *f=fopen(filename, "r");
+
+	if (!f) {
+		fprintf(stderr, "cannot read %s\n", filename);
+		return 2;
+	}
+	while (fgets(line, sizeof(line), f)) {
+		converged=-1;
+		if (sscanf(line, "%15[^,],%15[^,],%15[^,],%d,%lf,%lf,%31[^,],%*[^,],%d,%31[^,]",
+				   topology, task, sigmoid, &batch, &forwardNs, &backprop, epochNs, &converged, epochsMean)<7) {
+			continue;		/* header */
+		}
+		for (i=0, found=0; i<NumResults && !found; i++) {
+			r=&Results[i];
+			found=!strcmp(r->Topology, topology) && !strcmp(r->Task, task) &&
+				  !strcmp(r->Sigmoid, sigmoid) && (r->Batch==batch);
+		}
+		if (!found) {
+			fprintf(stderr, "not run: %s %s %s batch %d\n", topology, task, sigmoid, batch);
+			regressions++;
+			continue;
+		}
+		if (tolerance>0) {
+			regressions+=Worse("forward ns", r, forwardNs, r->ForwardNs, tolerance);
+			regressions+=Worse("backprop ns", r, backprop, r->BackpropNs, tolerance);
+		}
+		if ((converged<0) || (r->EpochNs<0)) continue;
+		if (tolerance>0) {
+			regressions+=Worse("epoch ns", r, atof(epochNs), r->EpochNs, tolerance);
+		}
+		if (r->Converged<converged) {
+			fprintf(stderr, "regression: %s %s %s batch %d: converged %d -> %d of %d\n",
+				r->Topology, r->Task, r->Sigmoid, r->Batch, converged, r->Converged, NUM_SEEDS);
+			regressions++;
+		}
+		else if (r->Converged==converged) {
+			regressions+=Worse("epochs", r, atof(epochsMean), r->EpochsMean, EPOCH_TOLERANCE);
+		}
+	}
+	fclose(f);
+	fprintf(stderr, "%d regressions against %s\n", regressions, filename);
+	return regressions ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+	const char *baseline=0;
+	double tolerance=0;
+	int opt;
+
+	while ((opt=getopt(argc, argv, "c:e:t:"))!=-1) {
+		switch (opt) {
+		case 'c': baseline=optarg; break;
+		case 'e': Eta=atof(optarg); break;
+		case 't': tolerance=atof(optarg); break;
+		default:
+			fprintf(stderr, "usage: %s [-e eta] [-c baseline.csv [-t percent]]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	SigmoidTableInit();
+	printf("%s\n", CSV_HEADER);
+	RunCases();
+	return baseline ? Compare(baseline, tolerance) : 0;
+}
@@ -0,0 +1,89 @@
+/*****************************************************************************************/
+/* Optimizer benchmark                                                                   */
+/*                                                                                       */
+/* Trains the 2-2-1 network of the firmware on XOR, AND and OR (targets 0.1/1.0) with    */
+/* each optimizer of optimizer.h, in float (TrainEpochOpt()) and in Q15                  */
+/* (TrainEpochOptQ15()), online and full batch, from NUM_SEEDS initializations.  Every   */
+/* method runs with its own eta, the one the firmware would use for it.  Reports the     */
+/* runs that reach an epoch error below BENCH_TARGET_ERROR within BENCH_MAX_EPOCHS, the  */
+/* mean and worst epochs of those, and the host time per run.  A seed gives the same     */
+/* initial weights to every optimizer.                                                   */
+/*****************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "benchTask.h"
+#include "supervisedNNFixed.h"
+
+#define NUM_SEEDS 64
+
+static const struct {
+	const char *Name;
+	int Method;
+	float Eta;
+} Methods[] = {
+	{"sgd",      OPT_SGD,      0.1f},
+	{"momentum", OPT_MOMENTUM, 0.1f},
+	{"nesterov", OPT_NESTEROV, 0.1f},
+	{"rmsprop",  OPT_RMSPROP,  0.02f},
+	{"adam",     OPT_ADAM,     0.05f},
+};
+static const int Batches[] = {1, NumPat};
+
+/* Q15 copy of the run, set up by Q15Init() */
+static long InWQ[NumIn+1][NumHid+1], HidWQ[NumHid+1][NumOut+1];
+static long InGQ[NumIn+1][NumHid+1], HidGQ[NumHid+1][NumOut+1];
+static long PatternsQ[NumPat][NumIn], TargetsQ[NumPat];
+
+static void Q15Init(tBenchRun *run)
+{
+	int p;
+
+	for (p=0; p<NumPat; p++) {
+		TargetsQ[p]=FloatToQ15(run->Targets[p]);
+		PatternsQ[p][0]=FloatToQ15(BenchPatterns[p][0]);
+		PatternsQ[p][1]=FloatToQ15(BenchPatterns[p][1]);
+	}
+	WeightsToQ15(run->InW, run->HidW, InWQ, HidWQ);
+	memset(InGQ, 0, sizeof(InGQ));
+	memset(HidGQ, 0, sizeof(HidGQ));
+}
+
+static int FloatEpoch(tBenchRun *run)
+{
+	return TrainEpochOpt(BenchPatterns, run->Targets, 0, NumPat, run->Batch, -1, -1, run->InW, run->HidW, run->InG, run->HidG, &run->Opt)<BENCH_TARGET_ERROR;
+}
+
+static int Q15Epoch(tBenchRun *run)
+{
+	return TrainEpochOptQ15(PatternsQ, TargetsQ, 0, NumPat, run->Batch, -Q15_ONE, -Q15_ONE, InWQ, HidWQ, InGQ, HidGQ, &run->Opt)<FloatToQ15(BENCH_TARGET_ERROR);
+}
+
+int main(void)
+{
+	tBenchRun run;
+	tBenchStats stats;
+	int t, m, b, fixed, seed;
+
+	printf("task  optimizer  type  batch  converged  epochs mean    max  us/run\n");
+	for (t=0; t<BENCH_TASKS; t++) {
+		for (b=0; b<(int)(sizeof(Batches)/sizeof(Batches[0])); b++) {
+			for (fixed=0; fixed<=1; fixed++) {
+				for (m=0; m<(int)(sizeof(Methods)/sizeof(Methods[0])); m++) {
+					BenchStatsStart(&stats);
+					for (seed=1; seed<=NUM_SEEDS; seed++) {
+						BenchRunInit(&run, &BenchTasks[t], seed);
+						BenchRunOptimizer(&run, Methods[m].Method, Methods[m].Eta, fixed);
+						run.Batch=Batches[b];
+						if (fixed) Q15Init(&run);
+						BenchStatsAdd(&stats, BenchConverge(&run, fixed ? Q15Epoch : FloatEpoch));
+					}
+					printf("%-5s %-9s  %-5s %5d  %5d/%-3d  %11.1f %6ld  %6.0f\n", BenchTasks[t].Name,
+						Methods[m].Name, fixed ? "q15" : "float", Batches[b], stats.Converged, NUM_SEEDS,
+						BenchStatsMean(&stats), stats.Max, BenchStatsSeconds(&stats)*1e6/NUM_SEEDS);
+				}
+			}
+		}
+	}
+	return 0;
+}
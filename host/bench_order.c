@@ -0,0 +1,58 @@
+/*****************************************************************************************/
+/* Pattern order benchmark                                                               */
+/*                                                                                       */
+/* Trains the 2-2-1 network of the firmware on XOR, AND and OR (targets 0.1/1.0, eta     */
+/* 0.1) with the patterns presented in a fixed order, reshuffled every epoch and drawn   */
+/* with replacement (PatternOrder()), online and in batches of 2.  For NUM_SEEDS seeds   */
+/* it reports how many runs reach an error below BENCH_TARGET_ERROR over the four        */
+/* patterns within BENCH_MAX_EPOCHS, and the mean and worst number of epochs of those    */
+/* that do.  A seed gives the same initial weights in every mode, only the order draws   */
+/* differ.                                                                               */
+/*****************************************************************************************/
+
+#include <stdio.h>
+#include "benchTask.h"
+
+#define NUM_SEEDS 64
+
+static const char *Modes[] = {"fixed", "shuffle", "sample"};
+static const int Batches[] = {1, 2};
+
+static const float Eta = 0.1;
+static int Mode;
+
+/* The epoch error only covers the patterns drawn, so a low one is checked on */
+/* the whole set                                                              */
+static int OrderEpoch(tBenchRun *run)
+{
+	unsigned short order[NumPat];
+	float error;
+
+	PatternOrder(order, NumPat, Mode);
+	error=TrainEpochOrder(BenchPatterns, run->Targets, order, NumPat, run->Batch, -1, -1, run->InW, run->HidW, run->InG, run->HidG, Eta);
+	return error<BENCH_TARGET_ERROR && BenchFullError(run)<BENCH_TARGET_ERROR;
+}
+
+int main(void)
+{
+	tBenchRun run;
+	tBenchStats stats;
+	int t, b, seed;
+
+	printf("task  order    batch  converged  epochs mean   max      ms\n");
+	for (t=0; t<BENCH_TASKS; t++) {
+		for (b=0; b<(int)(sizeof(Batches)/sizeof(Batches[0])); b++) {
+			for (Mode=ORDER_FIXED; Mode<=ORDER_SAMPLE; Mode++) {
+				BenchStatsStart(&stats);
+				for (seed=1; seed<=NUM_SEEDS; seed++) {
+					BenchRunInit(&run, &BenchTasks[t], seed);
+					run.Batch=Batches[b];
+					BenchStatsAdd(&stats, BenchConverge(&run, OrderEpoch));
+				}
+				printf("%-5s %-8s %5d  %5d/%-3d  %11.1f %6ld  %6.1f\n", BenchTasks[t].Name, Modes[Mode], Batches[b],
+					stats.Converged, NUM_SEEDS, BenchStatsMean(&stats), stats.Max, BenchStatsSeconds(&stats)*1e3);
+			}
+		}
+	}
+	return 0;
+}
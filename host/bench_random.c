@@ -0,0 +1,111 @@
+/*****************************************************************************************/
+/* Random number benchmark                                                               */
+/*                                                                                       */
+/* Compares the xoshiro128+ generator of prng.h, one PRNGFloat() per value and in bulk   */
+/* with PRNGFill(), against the former getrandom_f(): libc rand() and a float divide by  */
+/* RAND_MAX+1.  Reports the host time per value, the mean, the variance (1/12 for a      */
+/* uniform [0,1)) and a chi-square over 64 buckets (63 degrees of freedom: about 63,     */
+/* above 100 is suspicious), and checks that a seed always gives the same sequence, that */
+/* PRNGFill() matches PRNGFloat() and that NNRandom starts as PRNGSeed(0).  The host has */
+/* an FPU and a fast rand(); on the soft-float Cortex-M3 the divide alone costs more     */
+/* than a whole PRNGFloat().                                                             */
+/*****************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "supervisedNN.h"
+#include "hostsim.h"
+
+#define NUM_VALUES 4096
+#define NUM_ROUNDS 2000
+#define NUM_BUCKETS 64
+
+static float Values[NUM_VALUES];
+static float Check[NUM_VALUES];
+volatile float Sink;
+
+static float RandLibc(float min, float max)
+{
+	return min + (rand()*(max-min)/(RAND_MAX + 1.0f));
+}
+
+static void Quality(const char *name, double ns)
+{
+	long buckets[NUM_BUCKETS];
+	double mean=0, var=0, chi2=0, expected=(double)NUM_VALUES/NUM_BUCKETS;
+	int i;
+
+	memset(buckets, 0, sizeof(buckets));
+	for (i=0; i<NUM_VALUES; i++) {
+		mean+=Values[i];
+		buckets[(int)(Values[i]*NUM_BUCKETS)]++;
+	}
+	mean/=NUM_VALUES;
+	for (i=0; i<NUM_VALUES; i++) {
+		var+=(Values[i]-mean)*(Values[i]-mean);
+	}
+	var/=NUM_VALUES;
+	for (i=0; i<NUM_BUCKETS; i++) {
+		chi2+=(buckets[i]-expected)*(buckets[i]-expected)/expected;
+	}
+	printf("%-20s %7.2f ns/value  mean %.4f  variance %.4f  chi2 %6.1f\n", name, ns, mean, var, chi2);
+}
+
+int main(void)
+{
+	double start, elapsed;
+	tPRNG rng, ref;
+	float acc=0;
+	int r, i, errors=0;
+
+	srand(1);
+	start=HostSimSeconds();
+	for (r=0; r<NUM_ROUNDS; r++) {
+		for (i=0; i<NUM_VALUES; i++) {
+			Values[i]=RandLibc(0, 1);
+		}
+		acc+=Values[r & (NUM_VALUES-1)];
+	}
+	elapsed=HostSimSeconds()-start;
+	Quality("rand() divide", elapsed*1e9/((double)NUM_ROUNDS*NUM_VALUES));
+
+	PRNGSeed(&rng, 1);
+	start=HostSimSeconds();
+	for (r=0; r<NUM_ROUNDS; r++) {
+		for (i=0; i<NUM_VALUES; i++) {
+			Values[i]=PRNGFloat(&rng, 0, 1);
+		}
+		acc+=Values[r & (NUM_VALUES-1)];
+	}
+	elapsed=HostSimSeconds()-start;
+	Quality("PRNGFloat()", elapsed*1e9/((double)NUM_ROUNDS*NUM_VALUES));
+
+	PRNGSeed(&rng, 1);
+	start=HostSimSeconds();
+	for (r=0; r<NUM_ROUNDS; r++) {
+		PRNGFill(&rng, Values, NUM_VALUES, 0, 1);
+		acc+=Values[r & (NUM_VALUES-1)];
+	}
+	elapsed=HostSimSeconds()-start;
+	Quality("PRNGFill()", elapsed*1e9/((double)NUM_ROUNDS*NUM_VALUES));
+	Sink=acc;
+
+	/* Same seed, same sequence, whichever way it is drawn */
+	PRNGSeed(&rng, 7);
+	PRNGFill(&rng, Values, NUM_VALUES, -1, 1);
+	PRNGSeed(&ref, 7);
+	for (i=0; i<NUM_VALUES; i++) {
+		Check[i]=PRNGFloat(&ref, -1, 1);
+	}
+	if (memcmp(Values, Check, sizeof(Values)) != 0 || memcmp(&rng, &ref, sizeof(rng)) != 0) {
+		printf("PRNGFill() and PRNGFloat() disagree\n");
+		errors++;
+	}
+	PRNGSeed(&ref, 0);
+	if (memcmp(&NNRandom, &ref, sizeof(ref)) != 0) {
+		printf("NNRandom does not start as PRNGSeed(0)\n");
+		errors++;
+	}
+	return errors ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+/*****************************************************************************************/
+/* Learning rate schedule benchmark                                                      */
+/*                                                                                       */
+/* Trains the 2-2-1 network of the firmware online on the XOR, AND and OR targets of     */
+/* targetFlag with the schedules of schedule.h, for the SGD and momentum optimizers at   */
+/* the firmware eta of 0.1, from NUM_SEEDS initializations.  Reports the runs that       */
+/* reach an epoch error below BENCH_TARGET_ERROR within BENCH_MAX_EPOCHS, the mean and   */
+/* worst epochs of those, the mean with the failed runs counted as BENCH_MAX_EPOCHS and  */
+/* the host time per run.  A seed gives the same initial weights to every schedule.      */
+/*****************************************************************************************/
+
+#include <stdio.h>
+#include "benchTask.h"
+#include "schedule.h"
+
+#define NUM_SEEDS 64
+
+static const char *Schedules[] = {"constant", "step", "exp", "bold"};
+static const char *Optimizers[] = {"sgd", "momentum"};
+
+static const float Eta = 0.1;
+static tSchedule Schedule;
+
+static int ScheduleEpoch(tBenchRun *run)
+{
+	float error;
+
+	error=TrainEpochOpt(BenchPatterns, run->Targets, 0, NumPat, 1, -1, -1, run->InW, run->HidW, run->InG, run->HidG, &run->Opt);
+	if (error<BENCH_TARGET_ERROR) return 1;
+	OptimizerSetEta(&run->Opt, ScheduleUpdate(&Schedule, error));
+	return 0;
+}
+
+int main(void)
+{
+	tBenchRun run;
+	tBenchStats stats;
+	int t, o, m, seed;
+
+	printf("task  optimizer schedule  converged  epochs mean    max  with failures  us/run\n");
+	for (t=0; t<BENCH_TASKS; t++) {
+		for (o=OPT_SGD; o<=OPT_MOMENTUM; o++) {
+			for (m=SCHED_CONSTANT; m<SCHED_MODES; m++) {
+				BenchStatsStart(&stats);
+				for (seed=1; seed<=NUM_SEEDS; seed++) {
+					BenchRunInit(&run, &BenchTasks[t], seed);
+					BenchRunOptimizer(&run, o, Eta, 0);
+					ScheduleInit(&Schedule, m, Eta);
+					BenchStatsAdd(&stats, BenchConverge(&run, ScheduleEpoch));
+				}
+				printf("%-5s %-9s %-9s %5d/%-3d  %11.1f %6ld  %13.1f  %6.0f\n", BenchTasks[t].Name,
+					Optimizers[o], Schedules[m], stats.Converged, NUM_SEEDS, BenchStatsMean(&stats),
+					stats.Max, BenchStatsMeanAll(&stats), BenchStatsSeconds(&stats)*1e6/NUM_SEEDS);
+			}
+		}
+	}
+	return 0;
+}
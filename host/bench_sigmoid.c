@@ -0,0 +1,101 @@
+/*****************************************************************************************/
+/* Sigmoid benchmark                                                                     */
+/*                                                                                       */
+/* Compares the table sigmoid (float and Q15) against the exact double precision exp()  */
+/* path: maximum and RMS error over [-12,12] and host time per call.  The host has an   */
+/* FPU, so the speed ratio understates the gain on the soft-float Cortex-M3.  Rebuild   */
+/* with "make clean; make SIGMOID_TABLE_BITS=n bench" to try another table size.        */
+/*****************************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include "supervisedNN.h"
+#include "hostsim.h"
+
+#define NUM_SAMPLES 4096
+#define NUM_ROUNDS 2000
+
+static float Samples[NUM_SAMPLES];
+static long SamplesQ[NUM_SAMPLES];
+volatile float Sink;
+
+static float SigmoidExpf(float x)
+{
+	return 1.0f/(1.0f+expf(-x));
+}
+
+static float SigmoidQ15AsFloat(float x)
+{
+	return (float)sigmoidQ15((long)(x*Q15_ONE))/Q15_ONE;
+}
+
+static float SigmoidExact(float x)
+{
+	return (float)sigmoid(x);
+}
+
+static void Accuracy(const char *name, float (*fn)(float))
+{
+	double x, err, maxErr=0, sumSq=0;
+	long n=0;
+
+	for (x=-12; x<=12; x+=1.0/1024) {
+		err=fabs(fn((float)x)-1/(1+exp(-x)));
+		if (err>maxErr) maxErr=err;
+		sumSq+=err*err;
+		n++;
+	}
+	printf("%-16s max error %.2e  rms error %.2e", name, maxErr, sqrt(sumSq/n));
+}
+
+static void Speed(float (*fn)(float))
+{
+	double start, elapsed;
+	float acc=0;
+	int r, i;
+
+	start=HostSimSeconds();
+	for (r=0; r<NUM_ROUNDS; r++) {
+		for (i=0; i<NUM_SAMPLES; i++) {
+			acc+=fn(Samples[i]);
+		}
+	}
+	elapsed=HostSimSeconds()-start;
+	Sink=acc;
+	printf("  %7.2f ns/call\n", elapsed*1e9/((double)NUM_ROUNDS*NUM_SAMPLES));
+}
+
+static void SpeedQ15(void)
+{
+	double start, elapsed;
+	long acc=0;
+	int r, i;
+
+	start=HostSimSeconds();
+	for (r=0; r<NUM_ROUNDS; r++) {
+		for (i=0; i<NUM_SAMPLES; i++) {
+			acc+=sigmoidQ15(SamplesQ[i]);
+		}
+	}
+	elapsed=HostSimSeconds()-start;
+	Sink=(float)acc;
+	printf("  %7.2f ns/call\n", elapsed*1e9/((double)NUM_ROUNDS*NUM_SAMPLES));
+}
+
+int main(void)
+{
+	int i;
+
+	for (i=0; i<NUM_SAMPLES; i++) {
+		Samples[i]=getrandom_f(-10.0, 10.0);
+		SamplesQ[i]=(long)(Samples[i]*Q15_ONE);
+	}
+	SigmoidTableInit();
+
+	printf("sigmoid table: %d entries over [0,%d]\n", SIGMOID_TABLE_SIZE, SIGMOID_RANGE);
+	Accuracy("exp() double", SigmoidExact);		Speed(SigmoidExact);
+	Accuracy("expf() float", SigmoidExpf);		Speed(SigmoidExpf);
+	Accuracy("table float", sigmoidTable);		Speed(sigmoidTable);
+	Accuracy("table Q15", SigmoidQ15AsFloat);	SpeedQ15();
+	return 0;
+}
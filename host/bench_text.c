@@ -0,0 +1,128 @@
+/*****************************************************************************************/
+/* Text drawing benchmark                                                                */
+/*                                                                                       */
+/* Host time to compose the results screen of NN_XOR.c into the OLED off-screen frame,   */
+/* with every string drawn by RIT128x96x4StringDraw() and with the static labels         */
+/* rendered once by RIT128x96x4TextRender() and drawn with RIT128x96x4ImageDraw().  The  */
+/* screen alternates between two sets of outputs so that every frame changes.  Also the  */
+/* time per character of RIT128x96x4StringDraw() for digits, which come from the glyph   */
+/* cache, and for letters, which are packed from the font.  Nothing is flushed, so this  */
+/* is CPU time only; the bus traffic is the same either way.  The saving of the labels   */
+/* is small and host dependent, compare it over several runs.                            */
+/*****************************************************************************************/
+
+#include <stdio.h>
+#include "supervisedNN.h"
+#include "hostsim.h"
+#include "inc/hw_types.h"
+#include "Drivers/rit128x96x4.h"
+
+#define NUM_ROUNDS 1000
+#define NUM_BATCHES 200		/* the best batch of each is reported, to filter out host noise */
+
+static const float Inputs[4][2] = {{0.1,0.1},{0.1,1.0},{1.0,0.1},{1.0,1.0}};
+static const float Targets[4] = {1.0, 0.1, 0.1, 1.0};
+static const float Outputs[2][4] = {{0.97,0.13,0.12,0.96},{0.52,0.48,0.51,0.49}};
+
+static unsigned char ResultsLabel[RIT_TEXT_BYTES(7)];
+static unsigned char InputsLabel[RIT_TEXT_BYTES(6)];
+static unsigned char EqualsLabel[RIT_TEXT_BYTES(1)];
+static unsigned long ResultsWidth, InputsWidth, EqualsWidth;
+
+static void Numbers(int set, int i)
+{
+	char str[32];
+
+	FloatStr(Inputs[i][0], 2, str);
+	RIT128x96x4StringDraw(str, 0, 10*i+10, 15);
+	FloatStr(Inputs[i][1], 2, str);
+	RIT128x96x4StringDraw(str, 30, 10*i+10, 15);
+	FloatStr(Outputs[set][i], 2, str);
+	RIT128x96x4StringDraw(str, 65, 10*i+10, 15);
+	FloatStr(Targets[i], 2, str);
+	RIT128x96x4StringDraw(str, 95, 10*i+10, 15);
+}
+
+static void ResultsStrings(int set)
+{
+	int i;
+
+	RIT128x96x4FrameClear();
+	RIT128x96x4StringDraw("Results", 60, 0, 15);
+	RIT128x96x4StringDraw("Inputs", 10, 0, 15);
+	for (i=0; i<4; i++) {
+		Numbers(set, i);
+		RIT128x96x4StringDraw("=", 54, 10*i+10, 15);
+	}
+}
+
+static void ResultsLabels(int set)
+{
+	int i;
+
+	RIT128x96x4FrameClear();
+	RIT128x96x4ImageDraw(ResultsLabel, 60, 0, ResultsWidth, 8);
+	RIT128x96x4ImageDraw(InputsLabel, 10, 0, InputsWidth, 8);
+	for (i=0; i<4; i++) {
+		Numbers(set, i);
+		RIT128x96x4ImageDraw(EqualsLabel, 54, 10*i+10, EqualsWidth, 8);
+	}
+}
+
+/* Time of one call of draw(), in us */
+static double Time(void (*draw)(int))
+{
+	double start=HostSimSeconds();
+	int r;
+
+	for (r=0; r<NUM_ROUNDS; r++) {
+		draw(r&1);
+	}
+	return (HostSimSeconds()-start)*1e6/NUM_ROUNDS;
+}
+
+static void FrameClear(int set)
+{
+	RIT128x96x4FrameClear();
+}
+
+static void Digits(int set)
+{
+	RIT128x96x4StringDraw(set ? "0123456789.-:" : "9876543210-.:", 0, 0, 15);
+}
+
+static void Letters(int set)
+{
+	RIT128x96x4StringDraw(set ? "Hidden Weight" : "Training Fini", 0, 0, 15);
+}
+
+static void (* const Draws[])(int) = {FrameClear, ResultsStrings, ResultsLabels, Digits, Letters};
+#define NUM_DRAWS (sizeof(Draws)/sizeof(Draws[0]))
+
+int main(void)
+{
+	double t, best[NUM_DRAWS];
+	unsigned int b, d;
+
+	ResultsWidth=RIT128x96x4TextRender("Results", 15, ResultsLabel);
+	InputsWidth=RIT128x96x4TextRender("Inputs", 15, InputsLabel);
+	EqualsWidth=RIT128x96x4TextRender("=", 15, EqualsLabel);
+
+	/* the draws take turns so that a slow period of the host hits all of them */
+	for (d=0; d<NUM_DRAWS; d++) best[d]=1e9;
+	for (b=0; b<NUM_BATCHES; b++) {
+		for (d=0; d<NUM_DRAWS; d++) {
+			t=Time(Draws[d]);
+			if (t<best[d]) best[d]=t;
+		}
+	}
+
+	printf("results screen, frame clear excluded:\n");
+	printf("  StringDraw only       %7.2f us\n", best[1]-best[0]);
+	printf("  pre-rendered labels   %7.2f us\n", best[2]-best[0]);
+	printf("  saved by the labels   %7.2f us (%.0f%%)\n", best[1]-best[2], (best[1]-best[2])*100/(best[1]-best[0]));
+	printf("StringDraw per character:\n");
+	printf("  digits                %7.2f ns\n", best[3]*1e3/13);
+	printf("  letters               %7.2f ns\n", best[4]*1e3/13);
+	return 0;
+}
@@ -0,0 +1,64 @@
+//*****************************************************************************
+//
+// adc.h - Host stand-in for the ADC driverlib API.
+//
+//*****************************************************************************
+
+#ifndef __ADC_H__
+#define __ADC_H__
+
+#include "inc/hw_types.h"
+
+//*****************************************************************************
+//
+// Values that can be passed to ADCSequenceConfigure as the ulTrigger
+// parameter.
+//
+//*****************************************************************************
+#define ADC_TRIGGER_PROCESSOR   0x00000000  // Processor event
+
+//*****************************************************************************
+//
+// Values that can be passed to ADCSequenceStepConfigure as the ulConfig
+// parameter.
+//
+//*****************************************************************************
+#define ADC_CTL_TS              0x00000080  // Temperature sensor select
+#define ADC_CTL_IE              0x00000040  // Interrupt enable
+#define ADC_CTL_END             0x00000020  // Sequence end select
+#define ADC_CTL_D               0x00000010  // Differential select
+#define ADC_CTL_CH0             0x00000000  // Input channel 0
+#define ADC_CTL_CH1             0x00000001  // Input channel 1
+#define ADC_CTL_CH2             0x00000002  // Input channel 2
+#define ADC_CTL_CH3             0x00000003  // Input channel 3
+
+extern void ADCIntRegister(unsigned long ulBase, unsigned long ulSequenceNum,
+                           void (*pfnHandler)(void));
+extern void ADCIntEnable(unsigned long ulBase, unsigned long ulSequenceNum);
+extern void ADCIntClear(unsigned long ulBase, unsigned long ulSequenceNum);
+extern unsigned long ADCIntStatus(unsigned long ulBase,
+                                  unsigned long ulSequenceNum,
+                                  tBoolean bMasked);
+extern void ADCSequenceEnable(unsigned long ulBase,
+                              unsigned long ulSequenceNum);
+extern void ADCSequenceDisable(unsigned long ulBase,
+                               unsigned long ulSequenceNum);
+extern void ADCSequenceConfigure(unsigned long ulBase,
+                                 unsigned long ulSequenceNum,
+                                 unsigned long ulTrigger,
+                                 unsigned long ulPriority);
+extern void ADCSequenceStepConfigure(unsigned long ulBase,
+                                     unsigned long ulSequenceNum,
+                                     unsigned long ulStep,
+                                     unsigned long ulConfig);
+extern long ADCSequenceDataGet(unsigned long ulBase,
+                               unsigned long ulSequenceNum,
+                               unsigned long *pulBuffer);
+extern void ADCProcessorTrigger(unsigned long ulBase,
+                                unsigned long ulSequenceNum);
+extern long ADCSequenceOverflow(unsigned long ulBase,
+                                unsigned long ulSequenceNum);
+extern void ADCSequenceOverflowClear(unsigned long ulBase,
+                                     unsigned long ulSequenceNum);
+
+#endif // __ADC_H__
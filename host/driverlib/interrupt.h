@@ -0,0 +1,17 @@
+//*****************************************************************************
+//
+// interrupt.h - Host stand-in for the NVIC driverlib API.
+//
+//*****************************************************************************
+
+#ifndef __INTERRUPT_H__
+#define __INTERRUPT_H__
+
+#include "inc/hw_types.h"
+
+extern tBoolean IntMasterEnable(void);
+extern tBoolean IntMasterDisable(void);
+extern void IntEnable(unsigned long ulInterrupt);
+extern void IntDisable(unsigned long ulInterrupt);
+
+#endif // __INTERRUPT_H__
@@ -0,0 +1,50 @@
+//*****************************************************************************
+//
+// sysctl.h - Host stand-in for the System Control driverlib API.
+//
+//*****************************************************************************
+
+#ifndef __SYSCTL_H__
+#define __SYSCTL_H__
+
+//*****************************************************************************
+//
+// The following are values that can be passed to SysCtlPeripheralEnable().
+//
+//*****************************************************************************
+#define SYSCTL_PERIPH_ADC0      0x00100001  // ADC0
+#define SYSCTL_PERIPH_SSI0      0x10000010  // SSI 0
+#define SYSCTL_PERIPH_GPIOA     0x20000001  // GPIO A
+#define SYSCTL_PERIPH_GPIOG     0x20000040  // GPIO G
+#define SYSCTL_PERIPH_GPIOH     0x20000080  // GPIO H
+
+//*****************************************************************************
+//
+// The following are values that can be passed to SysCtlADCSpeedSet().
+//
+//*****************************************************************************
+#define SYSCTL_ADCSPEED_1MSPS   0x00000300  // 1,000,000 samples per second
+#define SYSCTL_ADCSPEED_500KSPS 0x00000200  // 500,000 samples per second
+#define SYSCTL_ADCSPEED_250KSPS 0x00000100  // 250,000 samples per second
+#define SYSCTL_ADCSPEED_125KSPS 0x00000000  // 125,000 samples per second
+
+//*****************************************************************************
+//
+// The following are values that can be passed to SysCtlClockSet().
+//
+//*****************************************************************************
+#define SYSCTL_SYSDIV_1         0x07800000  // Processor clock is osc/pll /1
+#define SYSCTL_SYSDIV_4         0x01C00000  // Processor clock is osc/pll /4
+#define SYSCTL_SYSDIV_10        0x04C00000  // Processor clock is osc/pll /10
+#define SYSCTL_USE_PLL          0x00000000  // System clock is the PLL clock
+#define SYSCTL_USE_OSC          0x00003800  // System clock is the osc clock
+#define SYSCTL_OSC_MAIN         0x00000000  // Osc source is main osc
+#define SYSCTL_XTAL_8MHZ        0x00000380  // External crystal is 8MHz
+
+extern void SysCtlPeripheralEnable(unsigned long ulPeripheral);
+extern void SysCtlClockSet(unsigned long ulConfig);
+extern unsigned long SysCtlClockGet(void);
+extern void SysCtlADCSpeedSet(unsigned long ulSpeed);
+extern void SysCtlSleep(void);
+
+#endif // __SYSCTL_H__
@@ -0,0 +1,19 @@
+//*****************************************************************************
+//
+// systick.h - Host stand-in for the SysTick driverlib API.
+//
+//*****************************************************************************
+
+#ifndef __SYSTICK_H__
+#define __SYSTICK_H__
+
+extern void SysTickEnable(void);
+extern void SysTickDisable(void);
+extern void SysTickPeriodSet(unsigned long ulPeriod);
+extern unsigned long SysTickPeriodGet(void);
+extern unsigned long SysTickValueGet(void);
+extern void SysTickIntRegister(void (*pfnHandler)(void));
+extern void SysTickIntEnable(void);
+extern void SysTickIntDisable(void);
+
+#endif // __SYSTICK_H__
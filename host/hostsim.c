@@ -0,0 +1,1167 @@
+//*****************************************************************************
+//
+// hostsim.c - Host stand-ins for the driverlib APIs used by NN_XOR.
+//
+// Peripherals are modelled only as far as the firmware observes them:
+//
+// - GPIO keeps the output latches, the interrupt enable mask and the pending
+//   interrupt status of every port.  Button presses are injected with
+//   HostSimButtonPress().
+// - The ADC sequencer returns the channel values set with HostSimADCSet() and
+//   raises its interrupt once per processor trigger; ADCIntStatus() polls the
+//   same flag.  A trigger that arrives before the previous conversion was read
+//   sets the FIFO overflow flag.
+// - SSI0 has an 8 entry transmit FIFO that drains at the programmed bit
+//   rate in host time, with the transmit FIFO half empty and receive timeout
+//   interrupts.  Every byte is received back as 0, like the unconnected RX
+//   pin on the board.  A byte reaches the SSD1329 emulator when its last bit
+//   is shifted out, and the D/C line is sampled from the GPIO port H pin 2
+//   latch at that moment, so toggling D/C too early corrupts the display as
+//   it would on the panel.  Data bytes are written into a 128x128
+//   nibble-packed display RAM honoring the column and row windows and the
+//   horizontal/vertical increment mode.
+// - SysTick counts down at the system clock rate, derived from the host's
+//   monotonic clock, so cycle counts measured with it are host time scaled
+//   to the configured clock.  Its interrupt is pending whenever the counter
+//   wrapped since the last delivery; several wraps collapse into one, as on
+//   the NVIC.
+// - Interrupts are delivered synchronously from HostSimDeliverInterrupts(),
+//   which SysCtlSleep() calls before handing control to the registered idle
+//   callback, and which IntMasterEnable() calls to take the interrupts that
+//   became pending while they were masked.  A SysTick wrap is also taken
+//   when thread code reads the counter, so the tick count and the counter
+//   stay consistent during long computations.  Handlers do not nest.
+// - The top HOST_FLASH_SIZE bytes of the flash are mapped read-only at their
+//   LM3S1968 addresses when the program starts, so the firmware reads them
+//   through plain pointers as on the board.  FlashErase() sets a 1 KB block
+//   to 0xFF and FlashProgram() can only clear bits, like the real array.
+//   Any other write to the window faults, like a bus fault on the board.
+//   HostSimFlashLoad() and HostSimFlashSave() keep its content across runs.
+//
+//*****************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/adc.h"
+#include "driverlib/flash.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/ssi.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/systick.h"
+#include "hostsim.h"
+
+//*****************************************************************************
+//
+// Shadow words backing HWREGBITW().
+//
+//*****************************************************************************
+#define HOST_BITBAND_SLOTS      16
+
+static struct
+{
+    volatile void *pvAddr;
+    unsigned long ulBit;
+    volatile unsigned long ulValue;
+}
+g_psBitBand[HOST_BITBAND_SLOTS];
+
+//*****************************************************************************
+//
+// System control and NVIC state.
+//
+//*****************************************************************************
+static unsigned long g_ulSysClock = 16000000;
+static tBoolean g_bMasterEnable;
+static tBoolean g_bInHandler;
+static unsigned char g_pucIntEnabled[NUM_INTERRUPTS];
+static void (*g_pfnIdle)(void);
+
+//*****************************************************************************
+//
+// SysTick state.
+//
+//*****************************************************************************
+static unsigned long g_ulSysTickPeriod = 0x1000000;
+static double g_dSysTickStart;
+static tBoolean g_bSysTickEnabled;
+static tBoolean g_bSysTickIntEnabled;
+static unsigned long long g_ullSysTickWraps;
+static void (*g_pfnSysTickHandler)(void);
+
+static tBoolean SysTickPending(void);
+static void SSIUpdate(void);
+static unsigned long SSIIntRaw(void);
+
+//*****************************************************************************
+//
+// GPIO state, one entry per port A-H.
+//
+//*****************************************************************************
+#define HOST_GPIO_PORTS         8
+
+static struct
+{
+    unsigned char ucData;
+    unsigned char ucIntMask;
+    unsigned char ucIntStatus;
+    void (*pfnHandler)(void);
+}
+g_psGPIO[HOST_GPIO_PORTS];
+
+//*****************************************************************************
+//
+// Flash window state.
+//
+//*****************************************************************************
+#define HOST_FLASH_BASE         0x00030000
+#define HOST_FLASH_SIZE         0x00010000
+#define HOST_FLASH_BLOCK        0x400
+
+static unsigned char *g_pucFlash;
+static unsigned long g_ulFlashUsec = 16;
+
+//*****************************************************************************
+//
+// ADC0 sequencer 1 state.
+//
+//*****************************************************************************
+static unsigned long g_pulADCStep[8];
+static unsigned long g_pulADCChannel[4];
+static tBoolean g_bADCIntEnabled;
+static tBoolean g_bADCPending;
+static tBoolean g_bADCUnread;
+static tBoolean g_bADCOverflow;
+static void (*g_pfnADCHandler)(void);
+
+//*****************************************************************************
+//
+// SSI and SSD1329 state.
+//
+//*****************************************************************************
+#define HOST_SSI_FIFO           8
+
+static tBoolean g_bSSIEnabled;
+static tHostSimSSIStats g_sSSIStats;
+static unsigned char g_pucSSITx[HOST_SSI_FIFO];
+static unsigned long g_ulSSITxHead, g_ulSSITxCount;
+static unsigned long g_ulSSIRxCount;
+static double g_dSSIShiftEnd;
+static tBoolean g_bSSITimeoutArmed;
+static unsigned long g_ulSSIRawInt;
+static unsigned long g_ulSSIIntMask;
+static void (*g_pfnSSIHandler)(void);
+static unsigned char g_pucGDDRAM[128][64];
+static unsigned char g_ucColStart, g_ucColEnd = 63, g_ucCol;
+static unsigned char g_ucRowStart, g_ucRowEnd = 127, g_ucRow;
+static unsigned char g_ucRemap;
+static unsigned char g_ucCommand, g_ucArgCount, g_ucArgIdx;
+static unsigned char g_pucArgs[16];
+
+//*****************************************************************************
+//
+// Bit-band emulation.
+//
+//*****************************************************************************
+volatile unsigned long *
+HostBitBand(volatile void *pvAddr, unsigned long ulBit)
+{
+    unsigned long ulIdx;
+
+    for(ulIdx = 0; ulIdx < HOST_BITBAND_SLOTS; ulIdx++)
+    {
+        if(g_psBitBand[ulIdx].pvAddr == 0)
+        {
+            g_psBitBand[ulIdx].pvAddr = pvAddr;
+            g_psBitBand[ulIdx].ulBit = ulBit;
+        }
+        if((g_psBitBand[ulIdx].pvAddr == pvAddr) &&
+           (g_psBitBand[ulIdx].ulBit == ulBit))
+        {
+            return(&g_psBitBand[ulIdx].ulValue);
+        }
+    }
+
+    fprintf(stderr, "hostsim: out of bit-band slots\n");
+    return(&g_psBitBand[0].ulValue);
+}
+
+//*****************************************************************************
+//
+// Map a GPIO base address onto the port table.
+//
+//*****************************************************************************
+static unsigned long
+GPIOPortIndex(unsigned long ulPort)
+{
+    switch(ulPort)
+    {
+        case GPIO_PORTA_BASE: return(0);
+        case GPIO_PORTB_BASE: return(1);
+        case GPIO_PORTC_BASE: return(2);
+        case GPIO_PORTD_BASE: return(3);
+        case GPIO_PORTE_BASE: return(4);
+        case GPIO_PORTF_BASE: return(5);
+        case GPIO_PORTG_BASE: return(6);
+        default:              return(7);
+    }
+}
+
+//*****************************************************************************
+//
+// Deliver every pending interrupt whose source and NVIC line are enabled.
+// SysTick goes first so that the conversion it triggers is delivered in the
+// same call.  The ADC handler may re-trigger its own conversion, so it runs
+// at most once per call to keep the simulation from livelocking.
+//
+//*****************************************************************************
+void
+HostSimDeliverInterrupts(void)
+{
+    unsigned long ulPort;
+
+    if(!g_bMasterEnable || g_bInHandler)
+    {
+        return;
+    }
+    g_bInHandler = true;
+
+    if(SysTickPending())
+    {
+        g_pfnSysTickHandler();
+    }
+
+    if(g_bADCPending && g_bADCIntEnabled && g_pfnADCHandler &&
+       g_pucIntEnabled[INT_ADC0SS1])
+    {
+        g_pfnADCHandler();
+    }
+
+    SSIUpdate();
+    if((SSIIntRaw() & g_ulSSIIntMask) && g_pfnSSIHandler &&
+       g_pucIntEnabled[INT_SSI0])
+    {
+        g_pfnSSIHandler();
+    }
+
+    for(ulPort = 0; ulPort < HOST_GPIO_PORTS; ulPort++)
+    {
+        if((g_psGPIO[ulPort].ucIntStatus & g_psGPIO[ulPort].ucIntMask) &&
+           g_psGPIO[ulPort].pfnHandler &&
+           ((ulPort != 6) || g_pucIntEnabled[INT_GPIOG]))
+        {
+            g_psGPIO[ulPort].pfnHandler();
+        }
+    }
+    g_bInHandler = false;
+}
+
+//*****************************************************************************
+//
+// Simulator control API.
+//
+//*****************************************************************************
+void
+HostSimIdleRegister(void (*pfnIdle)(void))
+{
+    g_pfnIdle = pfnIdle;
+}
+
+void
+HostSimButtonPress(unsigned char ucPins)
+{
+    g_psGPIO[GPIOPortIndex(GPIO_PORTG_BASE)].ucIntStatus |= ucPins;
+    HostSimDeliverInterrupts();
+}
+
+int
+HostSimFlashLoad(const char *pcFilename)
+{
+    FILE *pFile;
+    int iRet;
+
+    pFile = fopen(pcFilename, "rb");
+    if(pFile == 0)
+    {
+        return(-1);
+    }
+    mprotect(g_pucFlash, HOST_FLASH_SIZE, PROT_READ | PROT_WRITE);
+    iRet = (fread(g_pucFlash, 1, HOST_FLASH_SIZE, pFile) == HOST_FLASH_SIZE) ?
+           0 : -1;
+    mprotect(g_pucFlash, HOST_FLASH_SIZE, PROT_READ);
+    fclose(pFile);
+    return(iRet);
+}
+
+int
+HostSimFlashSave(const char *pcFilename)
+{
+    FILE *pFile;
+    int iRet;
+
+    pFile = fopen(pcFilename, "wb");
+    if(pFile == 0)
+    {
+        return(-1);
+    }
+    iRet = (fwrite(g_pucFlash, 1, HOST_FLASH_SIZE, pFile) == HOST_FLASH_SIZE) ?
+           0 : -1;
+    if(fclose(pFile) != 0)
+    {
+        iRet = -1;
+    }
+    return(iRet);
+}
+
+void
+HostSimADCSet(unsigned long ulCh0, unsigned long ulCh1)
+{
+    g_pulADCChannel[0] = ulCh0 & 0x3ff;
+    g_pulADCChannel[1] = ulCh1 & 0x3ff;
+}
+
+unsigned char
+HostSimPixelGet(unsigned long ulX, unsigned long ulY)
+{
+    unsigned char ucByte;
+
+    if((ulX >= HOSTSIM_OLED_WIDTH) || (ulY >= HOSTSIM_OLED_HEIGHT))
+    {
+        return(0);
+    }
+    ucByte = g_pucGDDRAM[ulY][ulX / 2];
+    return((ulX & 1) ? (ucByte & 0x0f) : (ucByte >> 4));
+}
+
+void
+HostSimScreenPrint(FILE *pFile)
+{
+    static const char pcShade[] = " .:-=+*#%@@@@@@@";
+    unsigned long ulX, ulY;
+
+    for(ulY = 0; ulY < HOSTSIM_OLED_HEIGHT; ulY++)
+    {
+        for(ulX = 0; ulX < HOSTSIM_OLED_WIDTH; ulX++)
+        {
+            fputc(pcShade[HostSimPixelGet(ulX, ulY)], pFile);
+        }
+        fputc('\n', pFile);
+    }
+}
+
+int
+HostSimScreenWritePGM(const char *pcFilename)
+{
+    FILE *pFile;
+    unsigned long ulX, ulY;
+
+    pFile = fopen(pcFilename, "wb");
+    if(pFile == 0)
+    {
+        return(-1);
+    }
+    fprintf(pFile, "P5\n%d %d\n15\n", HOSTSIM_OLED_WIDTH, HOSTSIM_OLED_HEIGHT);
+    for(ulY = 0; ulY < HOSTSIM_OLED_HEIGHT; ulY++)
+    {
+        for(ulX = 0; ulX < HOSTSIM_OLED_WIDTH; ulX++)
+        {
+            fputc(HostSimPixelGet(ulX, ulY), pFile);
+        }
+    }
+    return(fclose(pFile));
+}
+
+void
+HostSimSSIStatsGet(tHostSimSSIStats *psStats)
+{
+    *psStats = g_sSSIStats;
+}
+
+void
+HostSimSSIStatsClear(void)
+{
+    unsigned long ulBitRate = g_sSSIStats.ulBitRate;
+
+    memset(&g_sSSIStats, 0, sizeof(g_sSSIStats));
+    g_sSSIStats.ulBitRate = ulBitRate;
+}
+
+//*****************************************************************************
+//
+// True while bytes are still shifting out or the OLED driver waits for an SSI
+// interrupt, i.e. while its transfer queue is still draining.
+//
+//*****************************************************************************
+int
+HostSimSSIBusy(void)
+{
+    SSIUpdate();
+    return((g_ulSSITxCount != 0) ||
+           ((g_ulSSIIntMask & (SSI_TXFF | SSI_RXTO)) != 0));
+}
+
+double
+HostSimSeconds(void)
+{
+    struct timespec sNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    return((double)sNow.tv_sec + (double)sNow.tv_nsec * 1e-9);
+}
+
+//*****************************************************************************
+//
+// System control.
+//
+//*****************************************************************************
+void
+SysCtlPeripheralEnable(unsigned long ulPeripheral)
+{
+}
+
+void
+SysCtlClockSet(unsigned long ulConfig)
+{
+    //
+    // Only the PLL (200MHz VCO / 2 / SYSDIV) and the 8MHz crystal are
+    // modelled.
+    //
+    if((ulConfig & SYSCTL_USE_OSC) == SYSCTL_USE_PLL)
+    {
+        g_ulSysClock = 200000000 / (((ulConfig >> 23) & 0xf) + 1);
+    }
+    else
+    {
+        g_ulSysClock = 8000000 / (((ulConfig >> 23) & 0xf) + 1);
+    }
+}
+
+unsigned long
+SysCtlClockGet(void)
+{
+    return(g_ulSysClock);
+}
+
+void
+SysCtlADCSpeedSet(unsigned long ulSpeed)
+{
+}
+
+void
+SysCtlSleep(void)
+{
+    HostSimDeliverInterrupts();
+    if(g_pfnIdle)
+    {
+        g_pfnIdle();
+    }
+}
+
+//*****************************************************************************
+//
+// SysTick.
+//
+//*****************************************************************************
+static unsigned long long
+SysTickCycles(void)
+{
+    return((unsigned long long)((HostSimSeconds() - g_dSysTickStart) *
+                                g_ulSysClock));
+}
+
+static tBoolean
+SysTickPending(void)
+{
+    unsigned long long ullWraps;
+
+    if(!g_bSysTickEnabled || !g_bSysTickIntEnabled || !g_pfnSysTickHandler)
+    {
+        return(false);
+    }
+    ullWraps = SysTickCycles() / g_ulSysTickPeriod;
+    if(ullWraps == g_ullSysTickWraps)
+    {
+        return(false);
+    }
+    g_ullSysTickWraps = ullWraps;
+    return(true);
+}
+
+void
+SysTickEnable(void)
+{
+    g_dSysTickStart = HostSimSeconds();
+    g_ullSysTickWraps = 0;
+    g_bSysTickEnabled = true;
+}
+
+void
+SysTickDisable(void)
+{
+    g_bSysTickEnabled = false;
+}
+
+void
+SysTickPeriodSet(unsigned long ulPeriod)
+{
+    g_ulSysTickPeriod = ulPeriod;
+}
+
+unsigned long
+SysTickPeriodGet(void)
+{
+    return(g_ulSysTickPeriod);
+}
+
+unsigned long
+SysTickValueGet(void)
+{
+    if(!g_bSysTickEnabled)
+    {
+        return(0);
+    }
+
+    //
+    // Take a wrap that happened in thread mode now, so that the tick count
+    // kept by the handler is up to date with the counter, as on the board.
+    //
+    if(g_bMasterEnable && !g_bInHandler && SysTickPending())
+    {
+        g_bInHandler = true;
+        g_pfnSysTickHandler();
+        g_bInHandler = false;
+    }
+    return(g_ulSysTickPeriod - 1 -
+           (unsigned long)(SysTickCycles() % g_ulSysTickPeriod));
+}
+
+void
+SysTickIntRegister(void (*pfnHandler)(void))
+{
+    g_pfnSysTickHandler = pfnHandler;
+    g_bSysTickIntEnabled = true;
+}
+
+void
+SysTickIntEnable(void)
+{
+    g_bSysTickIntEnabled = true;
+}
+
+void
+SysTickIntDisable(void)
+{
+    g_bSysTickIntEnabled = false;
+}
+
+//*****************************************************************************
+//
+// NVIC.
+//
+//*****************************************************************************
+tBoolean
+IntMasterEnable(void)
+{
+    tBoolean bOld = !g_bMasterEnable;
+
+    g_bMasterEnable = true;
+    if(bOld)
+    {
+        HostSimDeliverInterrupts();
+    }
+    return(bOld);
+}
+
+tBoolean
+IntMasterDisable(void)
+{
+    tBoolean bOld = !g_bMasterEnable;
+
+    g_bMasterEnable = false;
+    return(bOld);
+}
+
+void
+IntEnable(unsigned long ulInterrupt)
+{
+    if(ulInterrupt < NUM_INTERRUPTS)
+    {
+        g_pucIntEnabled[ulInterrupt] = 1;
+    }
+}
+
+void
+IntDisable(unsigned long ulInterrupt)
+{
+    if(ulInterrupt < NUM_INTERRUPTS)
+    {
+        g_pucIntEnabled[ulInterrupt] = 0;
+    }
+}
+
+//*****************************************************************************
+//
+// GPIO.
+//
+//*****************************************************************************
+void
+GPIOPinTypeGPIOInput(unsigned long ulPort, unsigned char ucPins)
+{
+}
+
+void
+GPIOPinTypeGPIOOutput(unsigned long ulPort, unsigned char ucPins)
+{
+}
+
+void
+GPIOPinTypeSSI(unsigned long ulPort, unsigned char ucPins)
+{
+}
+
+void
+GPIOPadConfigSet(unsigned long ulPort, unsigned char ucPins,
+                 unsigned long ulStrength, unsigned long ulPadType)
+{
+}
+
+void
+GPIOPinWrite(unsigned long ulPort, unsigned char ucPins, unsigned char ucVal)
+{
+    unsigned long ulIdx = GPIOPortIndex(ulPort);
+
+    //
+    // Bytes that finished shifting before the OLED D/C line changes are
+    // latched with its old level.
+    //
+    if(ulPort == GPIO_PORTH_BASE)
+    {
+        SSIUpdate();
+    }
+    g_psGPIO[ulIdx].ucData = (g_psGPIO[ulIdx].ucData & ~ucPins) |
+                             (ucVal & ucPins);
+}
+
+long
+GPIOPinRead(unsigned long ulPort, unsigned char ucPins)
+{
+    return(g_psGPIO[GPIOPortIndex(ulPort)].ucData & ucPins);
+}
+
+void
+GPIOPinIntEnable(unsigned long ulPort, unsigned char ucPins)
+{
+    g_psGPIO[GPIOPortIndex(ulPort)].ucIntMask |= ucPins;
+}
+
+void
+GPIOPinIntDisable(unsigned long ulPort, unsigned char ucPins)
+{
+    g_psGPIO[GPIOPortIndex(ulPort)].ucIntMask &= ~ucPins;
+}
+
+long
+GPIOPinIntStatus(unsigned long ulPort, tBoolean bMasked)
+{
+    unsigned long ulIdx = GPIOPortIndex(ulPort);
+
+    if(bMasked)
+    {
+        return(g_psGPIO[ulIdx].ucIntStatus & g_psGPIO[ulIdx].ucIntMask);
+    }
+    return(g_psGPIO[ulIdx].ucIntStatus);
+}
+
+void
+GPIOPinIntClear(unsigned long ulPort, unsigned char ucPins)
+{
+    g_psGPIO[GPIOPortIndex(ulPort)].ucIntStatus &= ~ucPins;
+}
+
+void
+GPIOPortIntRegister(unsigned long ulPort, void (*pfnIntHandler)(void))
+{
+    g_psGPIO[GPIOPortIndex(ulPort)].pfnHandler = pfnIntHandler;
+}
+
+//*****************************************************************************
+//
+// ADC.
+//
+//*****************************************************************************
+void
+ADCIntRegister(unsigned long ulBase, unsigned long ulSequenceNum,
+               void (*pfnHandler)(void))
+{
+    g_pfnADCHandler = pfnHandler;
+}
+
+void
+ADCIntEnable(unsigned long ulBase, unsigned long ulSequenceNum)
+{
+    g_bADCIntEnabled = true;
+}
+
+void
+ADCIntClear(unsigned long ulBase, unsigned long ulSequenceNum)
+{
+    g_bADCPending = false;
+}
+
+unsigned long
+ADCIntStatus(unsigned long ulBase, unsigned long ulSequenceNum,
+             tBoolean bMasked)
+{
+    if(bMasked && !g_bADCIntEnabled)
+    {
+        return(0);
+    }
+    return(g_bADCPending);
+}
+
+void
+ADCSequenceEnable(unsigned long ulBase, unsigned long ulSequenceNum)
+{
+}
+
+void
+ADCSequenceDisable(unsigned long ulBase, unsigned long ulSequenceNum)
+{
+}
+
+void
+ADCSequenceConfigure(unsigned long ulBase, unsigned long ulSequenceNum,
+                     unsigned long ulTrigger, unsigned long ulPriority)
+{
+}
+
+void
+ADCSequenceStepConfigure(unsigned long ulBase, unsigned long ulSequenceNum,
+                         unsigned long ulStep, unsigned long ulConfig)
+{
+    if(ulStep < 8)
+    {
+        g_pulADCStep[ulStep] = ulConfig;
+    }
+}
+
+long
+ADCSequenceDataGet(unsigned long ulBase, unsigned long ulSequenceNum,
+                   unsigned long *pulBuffer)
+{
+    long lCount = 0;
+
+    g_bADCUnread = false;
+
+    //
+    // Sequencer 1 holds up to four steps; stop after the END step.
+    //
+    while(lCount < 4)
+    {
+        pulBuffer[lCount] = g_pulADCChannel[g_pulADCStep[lCount] & 3];
+        if(g_pulADCStep[lCount++] & ADC_CTL_END)
+        {
+            break;
+        }
+    }
+    return(lCount);
+}
+
+void
+ADCProcessorTrigger(unsigned long ulBase, unsigned long ulSequenceNum)
+{
+    if(g_bADCUnread)
+    {
+        g_bADCOverflow = true;
+    }
+    g_bADCUnread = true;
+    g_bADCPending = true;
+}
+
+long
+ADCSequenceOverflow(unsigned long ulBase, unsigned long ulSequenceNum)
+{
+    return(g_bADCOverflow);
+}
+
+void
+ADCSequenceOverflowClear(unsigned long ulBase, unsigned long ulSequenceNum)
+{
+    g_bADCOverflow = false;
+}
+
+//*****************************************************************************
+//
+// Flash.  The window is mapped before main() runs; it starts erased.
+//
+//*****************************************************************************
+static void __attribute__((constructor))
+FlashMap(void)
+{
+    void *pvMap;
+
+    pvMap = mmap((void *)HOST_FLASH_BASE, HOST_FLASH_SIZE,
+                 PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if(pvMap != (void *)HOST_FLASH_BASE)
+    {
+        fprintf(stderr, "hostsim: cannot map the flash at 0x%08x\n",
+                HOST_FLASH_BASE);
+        return;
+    }
+    g_pucFlash = pvMap;
+    memset(g_pucFlash, 0xff, HOST_FLASH_SIZE);
+    mprotect(g_pucFlash, HOST_FLASH_SIZE, PROT_READ);
+}
+
+void
+FlashUsecSet(unsigned long ulClocks)
+{
+    g_ulFlashUsec = ulClocks;
+}
+
+unsigned long
+FlashUsecGet(void)
+{
+    return(g_ulFlashUsec);
+}
+
+long
+FlashErase(unsigned long ulAddress)
+{
+    if((ulAddress & (HOST_FLASH_BLOCK - 1)) || !g_pucFlash ||
+       (ulAddress < HOST_FLASH_BASE) ||
+       (ulAddress >= HOST_FLASH_BASE + HOST_FLASH_SIZE))
+    {
+        return(-1);
+    }
+    mprotect(g_pucFlash, HOST_FLASH_SIZE, PROT_READ | PROT_WRITE);
+    memset(g_pucFlash + (ulAddress - HOST_FLASH_BASE), 0xff,
+           HOST_FLASH_BLOCK);
+    mprotect(g_pucFlash, HOST_FLASH_SIZE, PROT_READ);
+    return(0);
+}
+
+long
+FlashProgram(unsigned long *pulData, unsigned long ulAddress,
+             unsigned long ulCount)
+{
+    const unsigned char *pucData = (const unsigned char *)pulData;
+    unsigned long ulIdx;
+
+    //
+    // Words are programmed as laid out in memory, so a record of 32 bit
+    // fields has the layout of the board even though a long is 64 bits here.
+    //
+    if((ulAddress & 3) || (ulCount & 3) || !g_pucFlash ||
+       (ulAddress < HOST_FLASH_BASE) ||
+       (ulAddress + ulCount > HOST_FLASH_BASE + HOST_FLASH_SIZE))
+    {
+        return(-1);
+    }
+    mprotect(g_pucFlash, HOST_FLASH_SIZE, PROT_READ | PROT_WRITE);
+    for(ulIdx = 0; ulIdx < ulCount; ulIdx++)
+    {
+        g_pucFlash[ulAddress - HOST_FLASH_BASE + ulIdx] &= pucData[ulIdx];
+    }
+    mprotect(g_pucFlash, HOST_FLASH_SIZE, PROT_READ);
+    return(0);
+}
+
+//*****************************************************************************
+//
+// SSD1329 command decoder.  Returns the number of parameter bytes that follow
+// the given command byte.
+//
+//*****************************************************************************
+static unsigned char
+SSD1329ArgCount(unsigned char ucCommand)
+{
+    switch(ucCommand)
+    {
+        case 0x15:
+        case 0x75:
+            return(2);
+        case 0xB8:
+            return(15);
+        case 0x81: case 0x82: case 0x94: case 0xA0: case 0xA1: case 0xA2:
+        case 0xA8: case 0xB1: case 0xB2: case 0xB3: case 0xBB: case 0xBC:
+        case 0xBE: case 0xFD:
+            return(1);
+        default:
+            return(0);
+    }
+}
+
+static void
+SSD1329Command(unsigned char ucByte)
+{
+    if(g_ucArgIdx == g_ucArgCount)
+    {
+        g_ucCommand = ucByte;
+        g_ucArgCount = SSD1329ArgCount(ucByte);
+        g_ucArgIdx = 0;
+    }
+    else
+    {
+        g_pucArgs[g_ucArgIdx++] = ucByte;
+    }
+
+    if(g_ucArgIdx != g_ucArgCount)
+    {
+        return;
+    }
+
+    switch(g_ucCommand)
+    {
+        case 0x15:
+            g_ucColStart = g_ucCol = g_pucArgs[0] & 63;
+            g_ucColEnd = g_pucArgs[1] & 63;
+            break;
+        case 0x75:
+            g_ucRowStart = g_ucRow = g_pucArgs[0] & 127;
+            g_ucRowEnd = g_pucArgs[1] & 127;
+            break;
+        case 0xA0:
+            g_ucRemap = g_pucArgs[0];
+            break;
+        default:
+            break;
+    }
+}
+
+static void
+SSD1329Data(unsigned char ucByte)
+{
+    g_pucGDDRAM[g_ucRow][g_ucCol] = ucByte;
+
+    if(g_ucRemap & 0x04)
+    {
+        //
+        // Vertical address increment.
+        //
+        if(g_ucRow++ >= g_ucRowEnd)
+        {
+            g_ucRow = g_ucRowStart;
+            g_ucCol = (g_ucCol >= g_ucColEnd) ? g_ucColStart : g_ucCol + 1;
+        }
+    }
+    else
+    {
+        //
+        // Horizontal address increment.
+        //
+        if(g_ucCol++ >= g_ucColEnd)
+        {
+            g_ucCol = g_ucColStart;
+            g_ucRow = (g_ucRow >= g_ucRowEnd) ? g_ucRowStart : g_ucRow + 1;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// SSI.
+//
+//*****************************************************************************
+void
+SSIConfigSetExpClk(unsigned long ulBase, unsigned long ulSSIClk,
+                   unsigned long ulProtocol, unsigned long ulMode,
+                   unsigned long ulBitRate, unsigned long ulDataWidth)
+{
+    g_sSSIStats.ulBitRate = ulBitRate;
+}
+
+void
+SSIEnable(unsigned long ulBase)
+{
+    g_bSSIEnabled = true;
+}
+
+void
+SSIDisable(unsigned long ulBase)
+{
+    g_bSSIEnabled = false;
+}
+
+//*****************************************************************************
+//
+// Deliver one byte that finished shifting out to the SSD1329 emulator.
+//
+//*****************************************************************************
+static void
+SSIShiftOut(unsigned char ucByte)
+{
+    if(g_sSSIStats.ulBitRate)
+    {
+        g_sSSIStats.dBusSeconds += 8.0 / (double)g_sSSIStats.ulBitRate;
+    }
+
+    //
+    // The OLED D/C line is GPIO port H pin 2: high for data, low for
+    // commands.
+    //
+    if(g_psGPIO[GPIOPortIndex(GPIO_PORTH_BASE)].ucData & GPIO_PIN_2)
+    {
+        g_sSSIStats.ulDataBytes++;
+        g_ucArgIdx = g_ucArgCount;
+        SSD1329Data(ucByte);
+    }
+    else
+    {
+        g_sSSIStats.ulCommandBytes++;
+        SSD1329Command(ucByte);
+    }
+
+    //
+    // The byte clocked in at the same time lands in the receive FIFO.
+    //
+    if(g_ulSSIRxCount < HOST_SSI_FIFO)
+    {
+        g_ulSSIRxCount++;
+    }
+    else
+    {
+        g_ulSSIRawInt |= SSI_RXOR;
+    }
+    g_bSSITimeoutArmed = true;
+}
+
+//*****************************************************************************
+//
+// Advance the SSI to the current host time: shift out every byte whose
+// transfer has completed and raise the receive timeout once the bus has been
+// idle for 32 bit periods.
+//
+//*****************************************************************************
+static void
+SSIUpdate(void)
+{
+    double dNow = HostSimSeconds();
+    double dByte, dBit;
+
+    dBit = g_sSSIStats.ulBitRate ? 1.0 / (double)g_sSSIStats.ulBitRate : 0;
+    dByte = 8 * dBit;
+
+    while(g_ulSSITxCount && (dNow >= g_dSSIShiftEnd))
+    {
+        SSIShiftOut(g_pucSSITx[g_ulSSITxHead]);
+        g_ulSSITxHead = (g_ulSSITxHead + 1) % HOST_SSI_FIFO;
+        if(--g_ulSSITxCount)
+        {
+            g_dSSIShiftEnd += dByte;
+        }
+    }
+
+    if(!g_ulSSITxCount && g_bSSITimeoutArmed && g_ulSSIRxCount &&
+       (dNow >= g_dSSIShiftEnd + 32 * dBit))
+    {
+        g_ulSSIRawInt |= SSI_RXTO;
+        g_bSSITimeoutArmed = false;
+    }
+}
+
+static unsigned long
+SSIIntRaw(void)
+{
+    unsigned long ulStatus = g_ulSSIRawInt;
+
+    if(g_ulSSITxCount <= HOST_SSI_FIFO / 2)
+    {
+        ulStatus |= SSI_TXFF;
+    }
+    if(g_ulSSIRxCount >= HOST_SSI_FIFO / 2)
+    {
+        ulStatus |= SSI_RXFF;
+    }
+    return(ulStatus);
+}
+
+long
+SSIDataPutNonBlocking(unsigned long ulBase, unsigned long ulData)
+{
+    if(!g_bSSIEnabled)
+    {
+        return(1);
+    }
+
+    SSIUpdate();
+    if(g_ulSSITxCount == HOST_SSI_FIFO)
+    {
+        return(0);
+    }
+    if(g_ulSSITxCount == 0)
+    {
+        g_dSSIShiftEnd = HostSimSeconds() +
+                         (g_sSSIStats.ulBitRate ?
+                          8.0 / (double)g_sSSIStats.ulBitRate : 0);
+    }
+    g_pucSSITx[(g_ulSSITxHead + g_ulSSITxCount++) % HOST_SSI_FIFO] =
+        (unsigned char)ulData;
+    return(1);
+}
+
+void
+SSIDataPut(unsigned long ulBase, unsigned long ulData)
+{
+    while(!SSIDataPutNonBlocking(ulBase, ulData))
+    {
+    }
+}
+
+long
+SSIDataGetNonBlocking(unsigned long ulBase, unsigned long *pulData)
+{
+    SSIUpdate();
+    if(!g_ulSSIRxCount)
+    {
+        return(0);
+    }
+    g_ulSSIRxCount--;
+    *pulData = 0;
+    return(1);
+}
+
+tBoolean
+SSIBusy(unsigned long ulBase)
+{
+    SSIUpdate();
+    return(g_ulSSITxCount != 0);
+}
+
+void
+SSIIntRegister(unsigned long ulBase, void (*pfnHandler)(void))
+{
+    g_pfnSSIHandler = pfnHandler;
+    IntEnable(INT_SSI0);
+}
+
+void
+SSIIntEnable(unsigned long ulBase, unsigned long ulIntFlags)
+{
+    g_ulSSIIntMask |= ulIntFlags;
+}
+
+void
+SSIIntDisable(unsigned long ulBase, unsigned long ulIntFlags)
+{
+    g_ulSSIIntMask &= ~ulIntFlags;
+}
+
+unsigned long
+SSIIntStatus(unsigned long ulBase, tBoolean bMasked)
+{
+    SSIUpdate();
+    return(bMasked ? (SSIIntRaw() & g_ulSSIIntMask) : SSIIntRaw());
+}
+
+void
+SSIIntClear(unsigned long ulBase, unsigned long ulIntFlags)
+{
+    g_ulSSIRawInt &= ~(ulIntFlags & (SSI_RXTO | SSI_RXOR));
+}
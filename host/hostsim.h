@@ -0,0 +1,62 @@
+//*****************************************************************************
+//
+// hostsim.h - Control interface of the host-side LM3S1968 simulator.
+//
+// The host build links the firmware against the driverlib stand-ins in
+// hostsim.c.  They keep the GPIO, ADC, interrupt and SSI state in memory and
+// emulate the SSD1329 controller of the RIT128x96x4 panel, so that every
+// byte the OLED driver sends lands in an in-memory frame buffer that can be
+// inspected or dumped.  This header is the side of the simulator that the
+// host programs (simulator, benchmarks) use to drive the firmware.
+//
+//*****************************************************************************
+
+#ifndef __HOSTSIM_H__
+#define __HOSTSIM_H__
+
+#include <stdio.h>
+
+//*****************************************************************************
+//
+// Size of the visible panel in pixels.
+//
+//*****************************************************************************
+#define HOSTSIM_OLED_WIDTH      128
+#define HOSTSIM_OLED_HEIGHT     96
+
+//*****************************************************************************
+//
+// Traffic counters of the simulated SSI port that feeds the OLED.  The bus
+// time is derived from the bit rate programmed with SSIConfigSetExpClk(), so
+// it reflects what the same traffic would cost on the board.
+//
+//*****************************************************************************
+typedef struct
+{
+    unsigned long ulCommandBytes;
+    unsigned long ulDataBytes;
+    unsigned long ulBitRate;
+    double dBusSeconds;
+}
+tHostSimSSIStats;
+
+//*****************************************************************************
+//
+// Prototypes for the simulator control API.
+//
+//*****************************************************************************
+extern void HostSimIdleRegister(void (*pfnIdle)(void));
+extern void HostSimDeliverInterrupts(void);
+extern void HostSimButtonPress(unsigned char ucPins);
+extern void HostSimADCSet(unsigned long ulCh0, unsigned long ulCh1);
+extern int HostSimFlashLoad(const char *pcFilename);
+extern int HostSimFlashSave(const char *pcFilename);
+extern unsigned char HostSimPixelGet(unsigned long ulX, unsigned long ulY);
+extern void HostSimScreenPrint(FILE *pFile);
+extern int HostSimScreenWritePGM(const char *pcFilename);
+extern void HostSimSSIStatsGet(tHostSimSSIStats *psStats);
+extern void HostSimSSIStatsClear(void);
+extern int HostSimSSIBusy(void);
+extern double HostSimSeconds(void);
+
+#endif // __HOSTSIM_H__
@@ -0,0 +1,17 @@
+//*****************************************************************************
+//
+// hw_ints.h - Host stand-in for the LM3S1968 interrupt assignments.
+//
+//*****************************************************************************
+
+#ifndef __HW_INTS_H__
+#define __HW_INTS_H__
+
+#define INT_GPIOA               16          // GPIO Port A
+#define INT_SSI0                23          // SSI0 Rx and Tx
+#define INT_ADC0SS1             31          // ADC0 Sequence 1
+#define INT_GPIOG               47          // GPIO Port G
+
+#define NUM_INTERRUPTS          64
+
+#endif // __HW_INTS_H__
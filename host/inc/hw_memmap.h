@@ -0,0 +1,27 @@
+//*****************************************************************************
+//
+// hw_memmap.h - Host stand-in for the LM3S1968 peripheral base addresses.
+//
+// The values match the device so that they can be printed and compared, but
+// they are only used as identifiers by the host simulator.
+//
+//*****************************************************************************
+
+#ifndef __HW_MEMMAP_H__
+#define __HW_MEMMAP_H__
+
+#define FLASH_BASE              0x00000000  // FLASH memory
+#define SRAM_BASE               0x20000000  // SRAM memory
+#define GPIO_PORTA_BASE         0x40004000  // GPIO Port A
+#define GPIO_PORTB_BASE         0x40005000  // GPIO Port B
+#define GPIO_PORTC_BASE         0x40006000  // GPIO Port C
+#define GPIO_PORTD_BASE         0x40007000  // GPIO Port D
+#define SSI0_BASE               0x40008000  // SSI0
+#define GPIO_PORTE_BASE         0x40024000  // GPIO Port E
+#define GPIO_PORTF_BASE         0x40025000  // GPIO Port F
+#define GPIO_PORTG_BASE         0x40026000  // GPIO Port G
+#define GPIO_PORTH_BASE         0x40027000  // GPIO Port H
+#define ADC0_BASE               0x40038000  // ADC0
+#define SYSCTL_BASE             0x400FE000  // System Control
+
+#endif // __HW_MEMMAP_H__
@@ -0,0 +1,13 @@
+//*****************************************************************************
+//
+// hw_ssi.h - Host stand-in for the SSI register definitions.
+//
+// The host simulator models the SSI port at the driverlib level, so no
+// register definitions are required.
+//
+//*****************************************************************************
+
+#ifndef __HW_SSI_H__
+#define __HW_SSI_H__
+
+#endif // __HW_SSI_H__
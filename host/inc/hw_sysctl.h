@@ -0,0 +1,13 @@
+//*****************************************************************************
+//
+// hw_sysctl.h - Host stand-in for the System Control register definitions.
+//
+// The host simulator models System Control at the driverlib level, so no
+// register definitions are required.
+//
+//*****************************************************************************
+
+#ifndef __HW_SYSCTL_H__
+#define __HW_SYSCTL_H__
+
+#endif // __HW_SYSCTL_H__
@@ -0,0 +1,41 @@
+//*****************************************************************************
+//
+// hw_types.h - Host stand-in for the StellarisWare common types and macros.
+//
+// Only the subset used by this project is provided.  The bit-band alias
+// region does not exist on the host, so HWREGBITW() is redirected to a small
+// table of shadow words maintained by the host simulator (hostsim.c).  This
+// works as long as a bit-banded variable is only ever accessed through
+// HWREGBITW(), which is how the OLED driver uses g_ulSSIFlags.
+//
+//*****************************************************************************
+
+#ifndef __HW_TYPES_H__
+#define __HW_TYPES_H__
+
+//*****************************************************************************
+//
+// Define a boolean type, and values for true and false.
+//
+//*****************************************************************************
+typedef unsigned char tBoolean;
+
+#ifndef true
+#define true 1
+#endif
+
+#ifndef false
+#define false 0
+#endif
+
+//*****************************************************************************
+//
+// Bit-band access, emulated with shadow words on the host.
+//
+//*****************************************************************************
+extern volatile unsigned long *HostBitBand(volatile void *pvAddr,
+                                           unsigned long ulBit);
+
+#define HWREGBITW(x, b)         (*HostBitBand((volatile void *)(x), (b)))
+
+#endif // __HW_TYPES_H__
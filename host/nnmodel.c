@@ -0,0 +1,323 @@
+/*****************************************************************************************/
+/* Model converter                                                                       */
+/*                                                                                       */
+/* Converts the binary models of nnModel.h to and from a readable text form, and builds  */
+/* them out of the weight store of a simulator flash image (NN_XOR_sim -f).              */
+/*                                                                                       */
+/*   nnmodel store flash.bin model.bin [q15]   trained weights of the flash image        */
+/*   nnmodel text model.bin [model.txt]        binary to text                            */
+/*   nnmodel bin model.txt model.bin           text to binary                            */
+/*   nnmodel c model.bin name [model.c]        const C array, to link the model in flash */
+/*   nnmodel run model.bin x...                mmap() the model and run it in place      */
+/*                                                                                       */
+/* The text gives the header fields one per line ("layers" is the count, then the        */
+/* sizes), then one line per neuron with its bias weight first, in the order of the      */
+/* binary.  Floats are printed with 9 digits, so a binary to text to binary round trip   */
+/* gives the same bytes.                                                                 */
+/* Lines starting with # are comments.                                                   */
+/*****************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "supervisedNN.h"
+#include "supervisedNNFixed.h"
+#include "weightStore.h"
+#include "nnModel.h"
+#include "hostsim.h"
+
+#define MAX_MODEL_BYTES 0x10000
+
+static const char *TypeNames[] = {"float", "q15"};
+static const char *ActNames[] = {"sigmoid", "linear"};
+
+static unsigned int Model[MAX_MODEL_BYTES/4];
+
+static int Name(const char *names[], int count, const char *name)
+{
+	int i;
+
+	for (i=0; i<count; i++) {
+		if (strcmp(names[i], name)==0) return i;
+	}
+	return -1;
+}
+
+static unsigned long ReadModel(const char *filename)
+{
+	FILE *file=fopen(filename, "rb");
+	unsigned long bytes;
+
+	if (file==0) {
+		perror(filename);
+		return 0;
+	}
+	bytes=fread(Model, 1, sizeof(Model), file);
+	fclose(file);
+	if (NNModelCheck((const tNNModel *)Model, bytes)!=0) {
+		fprintf(stderr, "%s: not a valid model\n", filename);
+		return 0;
+	}
+	return NNModelBytes((const tNNModel *)Model);
+}
+
+static int WriteModel(const char *filename)
+{
+	FILE *file=fopen(filename, "wb");
+	unsigned long bytes=NNModelBytes((const tNNModel *)Model);
+
+	if (file==0 || fwrite(Model, 1, bytes, file)!=bytes || fclose(file)!=0) {
+		perror(filename);
+		return 1;
+	}
+	return 0;
+}
+
+/* Model of the newest weight record of a simulator flash image */
+static int Store(const char *flash, const char *filename, int type)
+{
+	tNNModel *model=(tNNModel *)Model;
+	const tWeightRecord *record;
+	unsigned short sizes[3];
+
+	if (HostSimFlashLoad(flash)!=0) {
+		perror(flash);
+		return 1;
+	}
+	record=WeightStoreFind();
+	if (record==0) {
+		fprintf(stderr, "%s: no weights stored\n", flash);
+		return 1;
+	}
+	sizes[0]=record->In;
+	sizes[1]=record->Hid;
+	sizes[2]=record->Out;
+	NNModelInit(model, sizeof(Model), sizes, 3, type, -1);
+	NNModelSetLayer(model, 0, &record->InWeights[0][1], NumHid+1, 1);
+	NNModelSetLayer(model, 1, &record->HidWeights[0][1], NumOut+1, 1);
+	NNModelSeal(model);
+	printf("%s: %u epochs, error %f, %lu bytes\n", filename, record->Epochs, record->Error,
+		NNModelBytes(model));
+	return WriteModel(filename);
+}
+
+static int Text(const char *filename, const char *output)
+{
+	const tNNModel *model=(const tNNModel *)Model;
+	const float *f;
+	const int *q;
+	FILE *file=stdout;
+	int l, i, j;
+
+	if (ReadModel(filename)==0) return 1;
+	if (output && (file=fopen(output, "w"))==0) {
+		perror(output);
+		return 1;
+	}
+	fprintf(file, "# nnModel.h model, %lu bytes\n", NNModelBytes(model));
+	fprintf(file, "version %u\n", model->Version);
+	fprintf(file, "type %s\n", TypeNames[model->Type]);
+	fprintf(file, "layers %u", model->LayerCount);
+	for (l=0; l<model->LayerCount; l++) fprintf(file, " %u", model->Size[l]);
+	fprintf(file, "\nhidden %s\noutput %s\n", ActNames[model->HidAct & 1], ActNames[model->OutAct & 1]);
+	fprintf(file, "bias %.9g\n", model->Bias);
+	for (l=0; l<model->LayerCount-1; l++) {
+		fprintf(file, "# layer %d to %d: bias", l, l+1);
+		for (i=1; i<=model->Size[l]; i++) fprintf(file, " w%d", i);
+		fprintf(file, "\n");
+		f=(const float *)NNModelLayer(model, l);
+		q=(const int *)f;
+		for (j=0; j<model->Size[l+1]; j++) {
+			for (i=0; i<=model->Size[l]; i++) {
+				if (model->Type==NN_MODEL_Q15) fprintf(file, "%s%d", i ? " " : "", *q++);
+				else fprintf(file, "%s%.9g", i ? " " : "", *f++);
+			}
+			fprintf(file, "\n");
+		}
+	}
+	fprintf(file, "# crc 0x%08X\n", model->Crc);
+	if (output) fclose(file);
+	return 0;
+}
+
+/* Next word of the text, comments skipped */
+static int Word(FILE *file, char *word, int size)
+{
+	int c;
+
+	for (;;) {
+		c=fgetc(file);
+		if (c=='#') {
+			while (c!='\n' && c!=EOF) c=fgetc(file);
+		}
+		if (c==EOF) return 0;
+		if (c>' ') break;
+	}
+	while (c>' ' && size>1) {
+		*word++=(char)c;
+		size--;
+		c=fgetc(file);
+	}
+	*word=0;
+	return 1;
+}
+
+static int Bin(const char *filename, const char *output)
+{
+	tNNModel *model=(tNNModel *)Model;
+	unsigned short sizes[NN_MODEL_MAX_LAYERS];
+	int type=NN_MODEL_FLOAT, hidAct=NN_MODEL_SIGMOID, outAct=NN_MODEL_SIGMOID, layers=0, l;
+	float bias=-1;
+	unsigned int *w;
+	unsigned long n;
+	char word[64]="";
+	char *end;
+	FILE *file=fopen(filename, "r");
+
+	if (file==0) {
+		perror(filename);
+		return 1;
+	}
+	/* Header fields, up to the first weight */
+	while (Word(file, word, sizeof(word))) {
+		if (strcmp(word, "version")==0) {
+			if (!Word(file, word, sizeof(word)) || atoi(word)!=NN_MODEL_VERSION) goto bad;
+		}
+		else if (strcmp(word, "type")==0) {
+			if (!Word(file, word, sizeof(word)) || (type=Name(TypeNames, 2, word))<0) goto bad;
+		}
+		else if (strcmp(word, "hidden")==0) {
+			if (!Word(file, word, sizeof(word)) || (hidAct=Name(ActNames, 2, word))<0) goto bad;
+		}
+		else if (strcmp(word, "output")==0) {
+			if (!Word(file, word, sizeof(word)) || (outAct=Name(ActNames, 2, word))<0) goto bad;
+		}
+		else if (strcmp(word, "bias")==0) {
+			if (!Word(file, word, sizeof(word))) goto bad;
+			bias=strtof(word, &end);
+			if (*end) goto bad;
+		}
+		else if (strcmp(word, "layers")==0) {
+			if (!Word(file, word, sizeof(word))) goto bad;
+			layers=atoi(word);
+			if (layers<2 || layers>NN_MODEL_MAX_LAYERS) goto bad;
+			for (l=0; l<layers; l++) {
+				if (!Word(file, word, sizeof(word))) goto bad;
+				n=strtoul(word, &end, 10);
+				if (*end || n==0 || n>0xFFFF) goto bad;
+				sizes[l]=(unsigned short)n;
+			}
+		}
+		else break;
+	}
+	if (layers==0 || NNModelInit(model, sizeof(Model), sizes, layers, type, bias)==0) goto bad;
+	model->HidAct=(unsigned char)hidAct;
+	model->OutAct=(unsigned char)outAct;
+	w=(unsigned int *)NNModelLayer(model, 0);
+	for (n=0; n<model->NumWeights; n++) {
+		if (n>0 && !Word(file, word, sizeof(word))) goto bad;
+		if (type==NN_MODEL_Q15) ((int *)w)[n]=(int)strtol(word, &end, 10);
+		else ((float *)w)[n]=strtof(word, &end);
+		if (*end || end==word) goto bad;
+	}
+	if (Word(file, word, sizeof(word))) goto bad;
+	fclose(file);
+	NNModelSeal(model);
+	return WriteModel(output);
+bad:
+	fprintf(stderr, "%s: unexpected \"%s\"\n", filename, word);
+	fclose(file);
+	return 1;
+}
+
+static int CArray(const char *filename, const char *name, const char *output)
+{
+	unsigned long bytes=ReadModel(filename), i;
+	FILE *file=stdout;
+
+	if (bytes==0) return 1;
+	if (output && (file=fopen(output, "w"))==0) {
+		perror(output);
+		return 1;
+	}
+	fprintf(file, "/* %s, run with NNModelForward((const tNNModel *)%s, ...) */\n", filename, name);
+	fprintf(file, "const unsigned int %s[%lu] = {", name, bytes/4);
+	for (i=0; i<bytes/4; i++) {
+		fprintf(file, "%s0x%08X,", (i%6) ? " " : "\n\t", Model[i]);
+	}
+	fprintf(file, "\n};\n");
+	if (output) fclose(file);
+	return 0;
+}
+
+/* The model is mapped read only and never copied, as it would run from flash */
+static int Run(const char *filename, int argc, char **argv)
+{
+	const tNNModel *model;
+	float act[MAX_MODEL_BYTES/4], inputs[256];
+	long actQ[MAX_MODEL_BYTES/4], inputsQ[256];
+	const float *out;
+	const long *outQ;
+	struct stat st;
+	int fd, i;
+
+	fd=open(filename, O_RDONLY);
+	if (fd<0 || fstat(fd, &st)!=0) {
+		perror(filename);
+		return 1;
+	}
+	model=(const tNNModel *)mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (model==MAP_FAILED) {
+		perror(filename);
+		return 1;
+	}
+	if (NNModelCheck(model, st.st_size)!=0 || NNModelActSize(model)>MAX_MODEL_BYTES/4 ||
+		model->Size[0]>256 || argc!=model->Size[0]) {
+		fprintf(stderr, "%s: not a valid model for %d inputs\n", filename, argc);
+		return 1;
+	}
+	for (i=0; i<argc; i++) {
+		inputs[i]=strtof(argv[i], 0);
+		inputsQ[i]=FloatToQ15(inputs[i]);
+	}
+	if (model->Type==NN_MODEL_Q15) {
+		outQ=NNModelForwardQ15(model, inputsQ, actQ);
+		for (i=0; i<model->Size[model->LayerCount-1]; i++) printf("%s%f", i ? " " : "", Q15ToFloat(outQ[i]));
+	}
+	else {
+		out=NNModelForward(model, inputs, act);
+		for (i=0; i<model->Size[model->LayerCount-1]; i++) printf("%s%f", i ? " " : "", out[i]);
+	}
+	printf("\n");
+	munmap((void *)model, st.st_size);
+	return 0;
+}
+
+static int Usage(void)
+{
+	fprintf(stderr,
+		"usage: nnmodel store flash.bin model.bin [q15]\n"
+		"       nnmodel text model.bin [model.txt]\n"
+		"       nnmodel bin model.txt model.bin\n"
+		"       nnmodel c model.bin name [model.c]\n"
+		"       nnmodel run model.bin x...\n");
+	return 2;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc>=4 && argc<=5 && strcmp(argv[1], "store")==0) {
+		if (argc==5 && strcmp(argv[4], "q15")!=0) return Usage();
+		return Store(argv[2], argv[3], argc==5 ? NN_MODEL_Q15 : NN_MODEL_FLOAT);
+	}
+	if (argc>=3 && argc<=4 && strcmp(argv[1], "text")==0) return Text(argv[2], argc==4 ? argv[3] : 0);
+	if (argc==4 && strcmp(argv[1], "bin")==0) return Bin(argv[2], argv[3]);
+	if (argc>=4 && argc<=5 && strcmp(argv[1], "c")==0) return CArray(argv[2], argv[3], argc==5 ? argv[4] : 0);
+	if (argc>=3 && strcmp(argv[1], "run")==0) return Run(argv[2], argc-3, argv+3);
+	return Usage();
+}